@@ -0,0 +1,20 @@
+#include "mainwindow.h"
+
+#include <QApplication>
+#include <QMessageBox>
+
+int main(int argc, char *argv[])
+{
+    QApplication a(argc, argv);
+    MainWindow w;
+
+    // "--telemetry <archivo>" graba los eventos de las partidas (ver engine/telemetry.h)
+    const QStringList arguments = a.arguments();
+    const int telemetry = arguments.indexOf("--telemetry");
+    if (telemetry > 0 && telemetry + 1 < arguments.size() && !w.openTelemetry(arguments[telemetry + 1])) {
+        QMessageBox::warning(&w, "Telemetría", "No se pudo crear " + arguments[telemetry + 1]);
+    }
+
+    w.show();
+    return a.exec();
+}
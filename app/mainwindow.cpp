@@ -0,0 +1,1105 @@
+#include "mainwindow.h"
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QGroupBox>
+#include <QMessageBox>
+#include <QFileDialog>
+#include <QFile>
+#include <QGraphicsTextItem>
+#include <QGraphicsRectItem>
+#include <QGraphicsEllipseItem>
+#include <QPainterPath>
+#include <QBrush>
+#include <QPen>
+#include <QFont>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+// Vista que mide cuanto tarda en pintar la escena
+class ProfiledGraphicsView : public QGraphicsView
+{
+public:
+    explicit ProfiledGraphicsView(QGraphicsScene *scene) : QGraphicsView(scene) {}
+
+protected:
+    void paintEvent(QPaintEvent *event) override
+    {
+        PROFILE_SCOPE("QGraphicsView::paintEvent", ProfileCategory::Render);
+        QGraphicsView::paintEvent(event);
+    }
+};
+
+} // namespace
+
+MainWindow::MainWindow(QWidget *parent)
+    : QMainWindow(parent),
+    overlayFrames(0),
+    engine(nullptr),
+    threadedShot(0),
+    replayRestart(false),
+    telemetryMatch(0),
+    shownBouncesLeft(-1),
+    bouncesLeft(3),
+    aiCancel(false),
+    hitMapCancel(false),
+    hitMapKey(0),
+    previewItem(nullptr)
+{
+
+    aiWatcher = new QFutureWatcher<PlannedShot>(this);
+    connect(aiWatcher, &QFutureWatcher<PlannedShot>::finished, this, &MainWindow::aiShotReady);
+
+    hitMapWatcher = new QFutureWatcher<QVector<HitSample>>(this);
+    connect(hitMapWatcher, &QFutureWatcher<QVector<HitSample>>::finished, this, &MainWindow::hitMapBatchReady);
+
+    // Inicializar timer antes de setupUI
+    timer = new QTimer(this);
+    timer->setInterval(16);  // ~60 FPS
+    connect(timer, &QTimer::timeout, this, &MainWindow::updateGame);
+
+    setupUI();
+    setupGame(Level());
+}
+
+MainWindow::~MainWindow()
+{
+    // La busqueda trabaja sobre su propia copia, pero lee aiCancel
+    aiCancel = true;
+    aiWatcher->waitForFinished();
+    hitMapCancel = true;
+    hitMapWatcher->waitForFinished();
+    delete engine;
+}
+
+bool MainWindow::openTelemetry(const QString& path)
+{
+    if (!telemetry.open(path, engine->getDamageFactor(), engine->getProjectileMass())) {
+        return false;
+    }
+    telemetry.beginMatch(telemetryMatch++);
+    return true;
+}
+
+void MainWindow::setupUI()
+{
+    QWidget *centralWidget = new QWidget(this);
+    setCentralWidget(centralWidget);
+
+    QVBoxLayout *mainLayout = new QVBoxLayout(centralWidget);
+
+    scene = new QGraphicsScene(this);
+    scene->setSceneRect(0, 0, 800, 600);
+    scene->setBackgroundBrush(QBrush(QColor(135, 206, 235)));
+
+    view = new ProfiledGraphicsView(scene);
+    view->setRenderHint(QPainter::Antialiasing);
+    mainLayout->addWidget(view);
+
+    QGroupBox *controlBox = new QGroupBox("Controles de Lanzamiento");
+    QHBoxLayout *controlLayout = new QHBoxLayout(controlBox);
+
+    QVBoxLayout *angleLayout = new QVBoxLayout();
+    angleLabel = new QLabel("Ángulo: 45°");
+    angleSlider = new QSlider(Qt::Horizontal);
+    angleSlider->setRange(0, 90);
+    angleSlider->setValue(45);
+    angleLayout->addWidget(angleLabel);
+    angleLayout->addWidget(angleSlider);
+    controlLayout->addLayout(angleLayout);
+
+    QVBoxLayout *speedLayout = new QVBoxLayout();
+    speedLabel = new QLabel("Velocidad: 150");
+    speedSlider = new QSlider(Qt::Horizontal);
+    speedSlider->setRange(50, 300);
+    speedSlider->setValue(150);
+    speedLayout->addWidget(speedLabel);
+    speedLayout->addWidget(speedSlider);
+    controlLayout->addLayout(speedLayout);
+
+    QVBoxLayout *timeScaleLayout = new QVBoxLayout();
+    QLabel *timeScaleLabel = new QLabel("Simulación:");
+    timeScaleCombo = new QComboBox();
+    const double timeScales[] = {0.25, 0.5, 1.0, 2.0, 4.0, 8.0};
+    for (double scale : timeScales) {
+        timeScaleCombo->addItem(QString("%1×").arg(scale), scale);
+    }
+    timeScaleCombo->setCurrentIndex(2);
+    timeScaleLayout->addWidget(timeScaleLabel);
+    timeScaleLayout->addWidget(timeScaleCombo);
+    controlLayout->addLayout(timeScaleLayout);
+
+    QVBoxLayout *volleyLayout = new QVBoxLayout();
+    QLabel *volleyLabel = new QLabel("Proyectiles:");
+    volleySpin = new QSpinBox();
+    volleySpin->setRange(1, GameEngine::maxProjectiles);
+    volleySpin->setValue(1);
+    volleyLayout->addWidget(volleyLabel);
+    volleyLayout->addWidget(volleySpin);
+    controlLayout->addLayout(volleyLayout);
+
+    aiCheck = new QCheckBox("Jugador 2: computadora");
+    controlLayout->addWidget(aiCheck);
+
+    threadCheck = new QCheckBox("Simular en otro hilo");
+    controlLayout->addWidget(threadCheck);
+
+    hitMapCheck = new QCheckBox("Mapa de golpes");
+    controlLayout->addWidget(hitMapCheck);
+
+    previewCheck = new QCheckBox("Vista previa");
+    controlLayout->addWidget(previewCheck);
+
+    launchButton = new QPushButton("LANZAR");
+    launchButton->setStyleSheet("QPushButton { background-color: #4CAF50; color: white; font-weight: bold; padding: 10px; }");
+    controlLayout->addWidget(launchButton);
+
+    saveReplayButton = new QPushButton("Guardar repetición");
+    controlLayout->addWidget(saveReplayButton);
+
+    loadLevelButton = new QPushButton("Abrir nivel");
+    controlLayout->addWidget(loadLevelButton);
+
+    // Medicion de tiempos por cuadro: solo existe si se compilaron las
+    // sondas (debug o CONFIG+=profiling)
+    profileCheck = nullptr;
+    traceButton = nullptr;
+    profileOverlay = nullptr;
+#ifdef ENGINE_PROFILING
+    profileCheck = new QCheckBox("Rendimiento");
+    controlLayout->addWidget(profileCheck);
+
+    traceButton = new QPushButton("Grabar traza");
+    traceButton->setCheckable(true);
+    controlLayout->addWidget(traceButton);
+
+    profileOverlay = new QLabel(view);
+    profileOverlay->setStyleSheet("background-color: rgba(0, 0, 0, 160); color: white; "
+                                  "font-family: monospace; padding: 4px;");
+    profileOverlay->move(8, 8);
+    profileOverlay->setVisible(false);
+
+    connect(profileCheck, &QCheckBox::toggled, this, &MainWindow::updateProfiling);
+    connect(traceButton, &QPushButton::toggled, this, &MainWindow::toggleTrace);
+#endif
+
+    mainLayout->addWidget(controlBox);
+
+    QHBoxLayout *statusLayout = new QHBoxLayout();
+    playerLabel = new QLabel("Turno: Jugador 1");
+    playerLabel->setStyleSheet("font-weight: bold; font-size: 14px;");
+    statusLabel = new QLabel("Ajusta el ángulo y velocidad, luego presiona LANZAR");
+    bouncesLabel = new QLabel();
+    updateBouncesLabel(3);
+    statusLayout->addWidget(playerLabel);
+    statusLayout->addStretch();
+    statusLayout->addWidget(bouncesLabel);
+    statusLayout->addWidget(statusLabel);
+    mainLayout->addLayout(statusLayout);
+
+    QHBoxLayout *historyLayout = new QHBoxLayout();
+    historySlider = new QSlider(Qt::Horizontal);
+    historyLabel = new QLabel();
+    resumeButton = new QPushButton("Reanudar");
+    resumeButton->setEnabled(false);
+    historyLayout->addWidget(new QLabel("Historial:"));
+    historyLayout->addWidget(historySlider, 1);
+    historyLayout->addWidget(historyLabel);
+    historyLayout->addWidget(resumeButton);
+    mainLayout->addLayout(historyLayout);
+
+    connect(angleSlider, &QSlider::valueChanged, this, &MainWindow::updateAngleLabel);
+    connect(speedSlider, &QSlider::valueChanged, this, &MainWindow::updateSpeedLabel);
+    connect(launchButton, &QPushButton::clicked, this, &MainWindow::launchProjectile);
+    connect(timeScaleCombo, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &MainWindow::updateTimeScale);
+    connect(aiCheck, &QCheckBox::toggled, this, &MainWindow::updateAiPlayer);
+    connect(saveReplayButton, &QPushButton::clicked, this, &MainWindow::saveReplay);
+    connect(loadLevelButton, &QPushButton::clicked, this, &MainWindow::loadLevel);
+    connect(hitMapCheck, &QCheckBox::toggled, this, &MainWindow::updateHitMap);
+    connect(angleSlider, &QSlider::valueChanged, this, &MainWindow::updateHitMap);
+    connect(speedSlider, &QSlider::valueChanged, this, &MainWindow::updateHitMap);
+    connect(previewCheck, &QCheckBox::toggled, this, &MainWindow::updatePreview);
+    connect(angleSlider, &QSlider::valueChanged, this, &MainWindow::updatePreview);
+    connect(speedSlider, &QSlider::valueChanged, this, &MainWindow::updatePreview);
+    connect(historySlider, &QSlider::valueChanged, this, &MainWindow::seekHistory);
+    connect(resumeButton, &QPushButton::clicked, this, &MainWindow::resumeFromHistory);
+
+    setWindowTitle("esto es un 5 profe");
+    resize(900, 750);
+}
+
+void MainWindow::setupGame(const Level& level)
+{
+
+    delete engine;
+    engine = new GameEngine(level.createEngine());
+    engine->setContinuousCollision(true);  // Evita que el proyectil atraviese bloques delgados
+    engine->setEventCallback(GameEventRing::collect, &engineEvents);
+    replay.begin(*engine, clock.getSubStepDt());
+    replayRestart = false;
+    history.begin(*engine);
+    telemetry.beginMatch(telemetryMatch++);
+
+    renderScene();
+    updateHistoryControls();
+
+}
+
+// Construye la escena una sola vez; despues solo se actualizan los
+// elementos de los bloques que cambian (processEngineEvents)
+void MainWindow::renderScene()
+{
+    scene->clear();
+    projectileItems.clear();
+    player1InfraItems.clear();
+    player2InfraItems.clear();
+    resistanceLabels1.clear();
+    resistanceLabels2.clear();
+    hitMapItems.clear();  // Se crean al dibujar el primer mapa
+
+    // La geometria (caja, suelo, cañones y rivales) es la del nivel cargado
+    const double width = engine->getBoxWidth();
+    const double height = engine->getBoxHeight();
+    const double floorY = engine->getFloorY();
+    scene->setSceneRect(0, 0, width, height);
+
+    // Dibujar suelo
+    scene->addRect(0, floorY, width, height - floorY, QPen(Qt::NoPen), QBrush(QColor(160, 82, 45)));
+
+    // Dibujar cannones/lanzadores
+    // Cannon Jugador 1 (esquina superior izquierda)
+    QPointF cannon1 = engine->getCannonPosition(1);
+    scene->addEllipse(cannon1.x() - 15, cannon1.y() - 15, 30, 30, QPen(Qt::black, 2), QBrush(QColor(70, 130, 180)));
+    scene->addRect(cannon1.x() - 20, cannon1.y() + 15, 40, 10, QPen(Qt::black, 2), QBrush(QColor(50, 50, 50)));
+
+    // Cannon Jugador 2 (esquina superior derecha)
+    QPointF cannon2 = engine->getCannonPosition(2);
+    scene->addEllipse(cannon2.x() - 15, cannon2.y() - 15, 30, 30, QPen(Qt::black, 2), QBrush(QColor(220, 20, 60)));
+    scene->addRect(cannon2.x() - 20, cannon2.y() + 15, 40, 10, QPen(Qt::black, 2), QBrush(QColor(50, 50, 50)));
+
+    // Figura "Rival" dibujada dentro de su zona
+    auto drawRival = [this](const QRectF& zone, const QString& name) {
+        const double x = zone.x() + 30;
+        const double y = zone.y();
+
+        // Cabeza
+        scene->addEllipse(x - 15, y + 10, 30, 30, QPen(Qt::black, 2), QBrush(Qt::white));
+        // Cuerpo
+        scene->addLine(x, y + 40, x, y + 70, QPen(Qt::black, 2));
+        // Brazos
+        scene->addLine(x, y + 50, x - 20, y + 60, QPen(Qt::black, 2));
+        scene->addLine(x, y + 50, x + 20, y + 60, QPen(Qt::black, 2));
+        // Piernas
+        scene->addLine(x, y + 70, x - 15, y + 100, QPen(Qt::black, 2));
+        scene->addLine(x, y + 70, x + 15, y + 100, QPen(Qt::black, 2));
+
+        // Texto "Rival"
+        QGraphicsTextItem *rivalText = scene->addText(name);
+        QFont rivalFont = rivalText->font();
+        rivalFont.setPointSize(10);
+        rivalFont.setBold(true);
+        rivalText->setFont(rivalFont);
+        rivalText->setPos(x - 20, y + 100);
+    };
+
+    // Fuente de las resistencias, compartida por todas las etiquetas
+    QFont resistanceFont;
+    resistanceFont.setPointSize(14);
+    resistanceFont.setBold(true);
+
+    // Dibujar infraestructura Jugador 1 con colores como en la imagen
+    const QVector<Infrastructure>& infra1 = engine->getPlayer1Infrastructure();
+    QColor player1Colors[3] = {QColor(255, 200, 150), QColor(255, 255, 255), QColor(255, 200, 150)};
+
+    for (int i = 0; i < infra1.size(); ++i) {
+        QRectF rect = infra1[i].getRect();
+        QGraphicsRectItem *item = scene->addRect(rect, QPen(Qt::black, 2), QBrush(player1Colors[i % 3]));
+        player1InfraItems.append(item);
+
+        QGraphicsTextItem *label = scene->addText(QString::number((int)infra1[i].getResistance()), resistanceFont);
+        label->setPos(rect.center().x() - 15, rect.center().y() - 15);
+        label->setDefaultTextColor(Qt::black);
+        resistanceLabels1.append(label);
+
+        item->setVisible(!infra1[i].isDestroyed());
+        label->setVisible(!infra1[i].isDestroyed());
+    }
+
+    // Dibujar figura "Rival" para Jugador 1
+    drawRival(engine->getRivalZone(1), "harlin");
+
+    // Dibujar infraestructura Jugador 2 con colores como en la imagen
+    const QVector<Infrastructure>& infra2 = engine->getPlayer2Infrastructure();
+    QColor player2Colors[3] = {QColor(255, 200, 150), QColor(255, 255, 255), QColor(255, 200, 150)};
+
+    for (int i = 0; i < infra2.size(); ++i) {
+        QRectF rect = infra2[i].getRect();
+        QGraphicsRectItem *item = scene->addRect(rect, QPen(Qt::black, 2), QBrush(player2Colors[i % 3]));
+        player2InfraItems.append(item);
+
+        QGraphicsTextItem *label = scene->addText(QString::number((int)infra2[i].getResistance()), resistanceFont);
+        label->setPos(rect.center().x() - 15, rect.center().y() - 15);
+        label->setDefaultTextColor(Qt::black);
+        resistanceLabels2.append(label);
+
+        item->setVisible(!infra2[i].isDestroyed());
+        label->setVisible(!infra2[i].isDestroyed());
+    }
+
+    // Dibujar figura "Rival" para Jugador 2
+    drawRival(engine->getRivalZone(2), "sebas");
+
+    // Etiquetas de jugadores
+    QGraphicsTextItem *p1Label = scene->addText("harlin");
+    p1Label->setPos(cannon1.x() - 5, cannon1.y() + 35);
+    p1Label->setDefaultTextColor(QColor(70, 130, 180));
+    QFont font = p1Label->font();
+    font.setBold(true);
+    font.setPointSize(10);
+    p1Label->setFont(font);
+
+    QGraphicsTextItem *p2Label = scene->addText("sebas");
+    p2Label->setPos(cannon2.x() - 75, cannon2.y() + 35);
+    p2Label->setDefaultTextColor(QColor(220, 20, 60));
+    p2Label->setFont(font);
+
+    // Vista previa: un solo trazo que se reemplaza al mover los sliders
+    previewItem = scene->addPath(QPainterPath(), QPen(QColor(40, 40, 40), 2, Qt::DotLine));
+    previewItem->setZValue(0.6);
+    previewItem->setVisible(false);
+
+    // Proyectiles: elementos fijos que se ocultan entre disparos
+    for (int i = 0; i < GameEngine::maxProjectiles; ++i) {
+        QGraphicsEllipseItem *item = scene->addEllipse(0, 0, 16, 16, QPen(Qt::black), QBrush(Qt::black));
+        item->setZValue(1);
+        item->setVisible(false);
+        projectileItems.append(item);
+    }
+}
+
+void MainWindow::updateGame()
+{
+    PROFILE_FRAME();
+    PROFILE_SCOPE("MainWindow::updateGame", ProfileCategory::Other);
+
+    if (!engine) {
+        timer->stop();
+        return;
+    }
+
+    if (threadedShot != 0) {
+        updateThreadedShot();
+        return;
+    }
+
+    if (!engine->getActiveProjectile()) {
+        timer->stop();
+        launchButton->setEnabled(true);
+        return;
+    }
+
+    // Pasos fijos que corresponden al tiempo real desde el cuadro anterior;
+    // si el temporizador se atrasa se simulan varios en este cuadro
+    int steps = clock.advance(frameTimer.restart() / 1000.0);
+
+    bool projectileActive = engine->hasActiveProjectiles();
+    {
+        PROFILE_SCOPE("GameEngine::update", ProfileCategory::Simulation);
+        for (int i = 0; i < steps && projectileActive; ++i) {
+            for (int p = 0; p < engine->getProjectileCount(); ++p) {
+                previousProjectilePos[p] = engine->getProjectile(p).getPosition();
+            }
+            for (int s = 0; s < clock.getSubSteps() && projectileActive; ++s) {
+                projectileActive = engine->update(clock.getSubStepDt());
+                history.recordStep(*engine, clock.getSubStepDt());
+            }
+        }
+    }
+    processEngineEvents();
+    updateProfileOverlay();
+    updateHistoryControls();
+
+    if (projectileActive) {
+        RenderSnapshot snapshot;
+        captureSnapshot(*engine, previousProjectilePos, snapshot);
+        updateProjectileItems(snapshot, clock.getAlpha());
+    } else {
+        hideProjectileItems();
+        finishShot();
+    }
+}
+
+// Disparo simulado en simulationThread: se reflejan sus eventos y se dibuja
+// su ultimo instantaneo; el motor de la interfaz no cambia hasta el final
+void MainWindow::updateThreadedShot()
+{
+    // Primero el instantaneo: los eventos se encolan antes de publicarlo, asi
+    // que al ver el final ya estan todos en la cola
+    simulationThread.updateSnapshot();
+    const RenderSnapshot& snapshot = simulationThread.getSnapshot();
+
+    {
+        PROFILE_SCOPE("MainWindow::processEngineEvents", ProfileCategory::Render);
+        GameEvent event;
+        while (simulationThread.popEvent(event)) {
+            applyEngineEvent(event);
+        }
+    }
+    updateProfileOverlay();
+
+    // Todavia no publico nada de este disparo
+    if (snapshot.shot != threadedShot) return;
+
+    if (!snapshot.finished) {
+        // Interpolar segun el tiempo real transcurrido desde que se publico
+        // el paso, no segun el temporizador de la interfaz
+        double alpha = 1.0;
+        if (snapshot.stepSeconds > 0) {
+            alpha = (snapshotClockNs() - snapshot.publishedNs) / 1e9 / snapshot.stepSeconds;
+        }
+        updateProjectileItems(snapshot, std::min(1.0, alpha));
+        return;
+    }
+
+    threadedShot = 0;
+    simulationThread.collectEngine(*engine);
+    history.recordInput(*engine);  // El vuelo del hilo queda como un solo cuadro
+    hideProjectileItems();
+    finishShot();
+}
+
+void MainWindow::finishShot()
+{
+    timer->stop();
+    launchButton->setEnabled(true);
+    threadCheck->setEnabled(true);
+
+    // Verificar si el juego terminó
+    if (engine->isGameOver()) {
+        QString message;
+        if (engine->getWinner() == 1) {
+            message = "¡JUGADOR 1 GANA!\n\n¡Has alcanzado al rival enemigo!";
+        } else {
+            message = "¡JUGADOR 2 GANA!\n\n¡Has alcanzado al rival enemigo!";
+        }
+
+        QMessageBox::information(this, "¡Juego Terminado!", message);
+    } else {
+        // Cambiar de turno (las etiquetas se actualizan con el evento)
+        engine->switchTurn();
+        history.recordInput(*engine);
+        processEngineEvents();
+
+        if (replayRestart) {
+            replay.begin(*engine, clock.getSubStepDt());
+            replayRestart = false;
+        }
+
+        if (isAiTurn()) {
+            startAiTurn();
+        }
+    }
+
+    updateHistoryControls();
+    updateHitMap();
+    updatePreview();
+}
+
+void MainWindow::updateProjectileItems(const RenderSnapshot& snapshot, double alpha)
+{
+    PROFILE_SCOPE("MainWindow::updateProjectileItems", ProfileCategory::Render);
+
+    for (int i = 0; i < projectileItems.size(); ++i) {
+        QGraphicsEllipseItem *item = projectileItems[i];
+        if (i >= snapshot.projectileCount || !snapshot.active[i]) {
+            item->setVisible(false);
+            continue;
+        }
+
+        // Interpolar entre el paso anterior y el actual
+        QPointF pos = snapshot.previous[i] + (snapshot.current[i] - snapshot.previous[i]) * alpha;
+
+        item->setPos(pos.x() - 8, pos.y() - 8);
+        item->setVisible(true);
+    }
+}
+
+void MainWindow::hideProjectileItems()
+{
+    for (QGraphicsEllipseItem *item : projectileItems) {
+        item->setVisible(false);
+    }
+}
+
+void MainWindow::launchProjectile()
+{
+    fireShot(angleSlider->value(), speedSlider->value(), volleySpin->value());
+}
+
+void MainWindow::fireShot(double angle, double speed, int count)
+{
+    // Se vuelve a jugar desde un paso anterior del historial
+    if (history.getCurrentFrame() != history.getLastFrame()) {
+        replay.begin(*engine, clock.getSubStepDt());
+        replayRestart = false;
+    }
+    replay.addShot(engine->getCurrentPlayer(), angle, speed, count, volleySpread);
+
+    if (threadCheck->isChecked()) {
+        // El hilo lanza sobre su copia; el evento de lanzamiento llega por su cola
+        threadedShot = simulationThread.launch(*engine, engine->getCurrentPlayer(), angle, speed,
+                                               count, volleySpread, clock);
+    } else {
+        engine->launchVolley(engine->getCurrentPlayer(), angle, speed, count, volleySpread);
+        history.recordInput(*engine);
+        processEngineEvents();
+
+        for (int p = 0; p < engine->getProjectileCount(); ++p) {
+            previousProjectilePos[p] = engine->getProjectile(p).getPosition();
+        }
+        clock.reset();
+        frameTimer.start();
+    }
+
+    launchButton->setEnabled(false);
+    threadCheck->setEnabled(false);
+
+    statusLabel->setText("Proyectil en vuelo...");
+
+    timer->start();
+    updateHistoryControls();
+    updateHitMap();
+    updatePreview();
+}
+
+bool MainWindow::isAiTurn() const
+{
+    return aiCheck->isChecked() && engine->getCurrentPlayer() == 2 && !engine->isGameOver();
+}
+
+void MainWindow::startAiTurn()
+{
+    if (aiWatcher->isRunning()) return;
+
+    launchButton->setEnabled(false);
+    statusLabel->setText("La computadora está pensando...");
+
+    PlannerSettings settings;
+    settings.timeBudgetMs = aiTimeBudgetMs;
+    settings.dt = clock.getSubStepDt();
+
+    // Copia del estado actual: la interfaz sigue usando el motor mientras tanto
+    GameEngine state(*engine);
+    aiCancel = false;
+    aiWatcher->setFuture(QtConcurrent::run([state, settings, this]() {
+        return planShot(state, settings, &aiCancel);
+    }));
+    updateHistoryControls();
+}
+
+void MainWindow::aiShotReady()
+{
+    // Si se desactivo la computadora mientras pensaba, el turno vuelve al humano
+    if (!isAiTurn()) {
+        launchButton->setEnabled(!engine->isGameOver());
+        statusLabel->setText("Ajusta el ángulo y velocidad, luego presiona LANZAR");
+        updateHistoryControls();
+        updateHitMap();
+        updatePreview();
+        return;
+    }
+
+    PlannedShot shot = aiWatcher->result();
+
+    // Mostrar en los sliders el disparo elegido
+    angleSlider->setValue(qRound(shot.angle));
+    speedSlider->setValue(qRound(shot.speed));
+
+    fireShot(shot.angle, shot.speed, 1);
+}
+
+void MainWindow::updateAiPlayer(bool enabled)
+{
+    updateHitMap();
+    updatePreview();
+
+    if (!enabled) {
+        aiCancel = true;
+        updateHistoryControls();
+        return;
+    }
+
+    // Si ya es el turno del jugador 2 y nada esta en vuelo, jugar ahora
+    if (isAiTurn() && !timer->isActive() && !engine->hasActiveProjectiles()) {
+        startAiTurn();
+    } else {
+        updateHistoryControls();
+    }
+}
+
+void MainWindow::loadLevel()
+{
+    QString path = QFileDialog::getOpenFileName(this, "Abrir nivel", QString(),
+                                                "Niveles (*.l5l *.txt);;Todos los archivos (*)");
+    if (path.isEmpty()) return;
+
+    Level level;
+    int errorLine = 0;
+    if (!level.loadFromFile(path, &errorLine)) {
+        QString reason = (errorLine > 0) ? QString("Línea %1 inválida").arg(errorLine)
+                                         : QString("No es un nivel válido");
+        QMessageBox::warning(this, "Nivel", reason + ": " + path);
+        return;
+    }
+
+    // La busqueda en curso usa una copia del motor anterior: se descarta
+    aiCancel = true;
+    aiWatcher->waitForFinished();
+    hitMapCancel = true;
+    hitMapWatcher->waitForFinished();
+    hitMaps.clear();
+    hitMapOrder.clear();
+    hitMapBatch.clear();
+    timer->stop();
+    simulationThread.cancel();
+    threadedShot = 0;
+    engineEvents.clear();
+
+    setupGame(level);
+
+    playerLabel->setText("Turno: Jugador 1");
+    statusLabel->setText("Ajusta el ángulo y velocidad, luego presiona LANZAR");
+    updateBouncesLabel(bouncesLeft = 3);
+    launchButton->setEnabled(true);
+    threadCheck->setEnabled(true);
+    updateHitMap();
+    updatePreview();
+}
+
+void MainWindow::updateProfiling(bool enabled)
+{
+    Profiler::instance().setEnabled(enabled);
+    if (profileOverlay) {
+        profileOverlay->setVisible(enabled);
+        profileOverlay->setText("Esperando cuadros...");
+        profileOverlay->adjustSize();
+    }
+}
+
+void MainWindow::updateProfileOverlay()
+{
+    // Se refresca cada 15 cuadros: actualizar el texto tambien cuesta
+    if (!profileOverlay || !profileOverlay->isVisible() || ++overlayFrames < 15) return;
+    overlayFrames = 0;
+
+    FrameStats stats = Profiler::instance().getFrameStats();
+    profileOverlay->setText(QString("FPS %1\np50 %2 ms  p99 %3 ms\nsimulación %4 ms  dibujo %5 ms")
+                                .arg(stats.fps, 0, 'f', 1)
+                                .arg(stats.p50, 0, 'f', 2)
+                                .arg(stats.p99, 0, 'f', 2)
+                                .arg(stats.simulationMs, 0, 'f', 2)
+                                .arg(stats.renderMs, 0, 'f', 2));
+    profileOverlay->adjustSize();
+}
+
+void MainWindow::toggleTrace(bool recording)
+{
+    Profiler& profiler = Profiler::instance();
+
+    if (recording) {
+        // Las sondas solo graban con el perfilador activo
+        if (profileCheck && !profileCheck->isChecked()) profileCheck->setChecked(true);
+        profiler.startTrace();
+        traceButton->setText("Detener traza");
+        return;
+    }
+
+    traceButton->setText("Grabar traza");
+    QByteArray trace = profiler.stopTrace();
+
+    QString path = QFileDialog::getSaveFileName(this, "Guardar traza", QString(),
+                                                "Traza de Chrome (*.json)");
+    if (path.isEmpty()) return;
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate) || file.write(trace) != trace.size()) {
+        QMessageBox::warning(this, "Traza", "No se pudo guardar " + path);
+    }
+}
+
+// Mapa de golpes de la situacion actual: la geometria no entra en la clave
+// porque al abrir un nivel se descartan todos
+quint64 MainWindow::currentHitMapKey() const
+{
+    return layoutKey(*engine) ^ (quint64(speedSlider->value()) * 0x9E3779B97F4A7C15ull);
+}
+
+void MainWindow::updateHitMap()
+{
+    // Con un disparo en vuelo o mientras juega la computadora el mapa no
+    // corresponde a lo que se ve
+    const bool visible = hitMapCheck->isChecked() && engine && !engine->isGameOver() &&
+                         !timer->isActive() && threadedShot == 0 && !isAiTurn() &&
+                         !engine->hasActiveProjectiles();
+    if (!visible) {
+        cancelHitMap();
+        hideHitMap();
+        return;
+    }
+
+    const quint64 key = currentHitMapKey();
+    auto cached = hitMaps.constFind(key);
+    if (cached != hitMaps.constEnd()) {
+        drawHitMap(*cached);
+    } else {
+        hideHitMap();
+    }
+
+    // La tanda en curso puede ser de otra velocidad o empezar lejos del
+    // angulo del slider: se cancela y hitMapBatchReady vuelve a llamar aqui
+    if (hitMapWatcher->isRunning()) {
+        cancelHitMap();
+        return;
+    }
+    startHitMapBatch(key);
+}
+
+void MainWindow::startHitMapBatch(quint64 key)
+{
+    if (!hitMaps.contains(key)) {
+        hitMaps.insert(key, HitMap());
+        hitMapOrder.append(key);
+        if (hitMapOrder.size() > hitMapCacheSize) {
+            hitMaps.remove(hitMapOrder.takeFirst());
+        }
+    }
+
+    const HitMap& map = *hitMaps.constFind(key);
+    QVector<int> batch = map.nextBatch(angleSlider->value());
+    if (batch.isEmpty()) return;
+
+    QVector<double> angles;
+    angles.reserve(batch.size());
+    for (int index : batch) {
+        angles.append(map.angleAt(index));
+    }
+
+    // Copia del estado actual, como en el turno de la computadora
+    GameEngine state(*engine);
+    const double speed = speedSlider->value();
+    const double dt = clock.getSubStepDt();
+    hitMapKey = key;
+    hitMapBatch = batch;
+    hitMapCancel = false;
+    hitMapWatcher->setFuture(QtConcurrent::run([state, angles, speed, dt, this]() {
+        return sampleShots(state, angles, speed, dt, 0, &hitMapCancel);
+    }));
+}
+
+void MainWindow::hitMapBatchReady()
+{
+    // Aunque la tanda se haya cancelado, lo calculado vale para su clave
+    const QVector<HitSample> samples = hitMapWatcher->result();
+    auto map = hitMaps.find(hitMapKey);
+    if (map != hitMaps.end() && samples.size() == hitMapBatch.size()) {
+        for (int k = 0; k < samples.size(); ++k) {
+            map->store(hitMapBatch[k], samples[k]);
+        }
+    }
+    hitMapBatch.clear();
+
+    // Dibuja lo nuevo y sigue con la tanda siguiente (o la reinicia)
+    updateHitMap();
+}
+
+void MainWindow::cancelHitMap()
+{
+    hitMapCancel = true;
+}
+
+void MainWindow::drawHitMap(const HitMap& map)
+{
+    PROFILE_SCOPE("MainWindow::drawHitMap", ProfileCategory::Render);
+
+    if (hitMapItems.isEmpty()) {
+        for (int i = 0; i < HitMap::sampleCount; ++i) {
+            QGraphicsEllipseItem *item = scene->addEllipse(0, 0, 8, 8, QPen(Qt::NoPen), QBrush(Qt::gray));
+            item->setZValue(0.5);  // Sobre los bloques y debajo de los proyectiles
+            item->setVisible(false);
+            hitMapItems.append(item);
+        }
+    }
+
+    double maxDamage = 0.0;
+    for (int i = 0; i < HitMap::sampleCount; ++i) {
+        if (map.sample(i).computed) maxDamage = std::max(maxDamage, map.sample(i).result.damage);
+    }
+
+    // Rojo si el disparo gana, de amarillo a naranja segun el daño y gris
+    // si no golpea ningun bloque; el punto del angulo del slider va marcado
+    const int player = engine->getCurrentPlayer();
+    const int focus = qRound(angleSlider->value() / HitMap::angleStep);
+    for (int i = 0; i < HitMap::sampleCount; ++i) {
+        const HitSample& sample = map.sample(i);
+        QGraphicsEllipseItem *item = hitMapItems[i];
+        item->setVisible(sample.computed);
+        if (!sample.computed) continue;
+
+        QColor color(90, 90, 90, 140);
+        if (sample.result.winner == player) {
+            color = QColor(220, 0, 0, 220);
+        } else if (sample.result.damage > 0) {
+            const double t = (maxDamage > 0) ? sample.result.damage / maxDamage : 1.0;
+            color = QColor::fromHsvF((60.0 - 30.0 * t) / 360.0, 1.0, 1.0, 0.8);
+        }
+        item->setBrush(color);
+        item->setPen(i == focus ? QPen(Qt::black, 2) : QPen(Qt::NoPen));
+        item->setPos(sample.impact.x() - 4, sample.impact.y() - 4);
+    }
+}
+
+void MainWindow::hideHitMap()
+{
+    for (QGraphicsEllipseItem *item : hitMapItems) {
+        item->setVisible(false);
+    }
+}
+
+void MainWindow::updatePreview()
+{
+    // Igual que el mapa de golpes, solo mientras el jugador apunta
+    const bool visible = previewCheck->isChecked() && engine && !engine->isGameOver() &&
+                         !timer->isActive() && threadedShot == 0 && !isAiTurn() &&
+                         !engine->hasActiveProjectiles();
+    previewItem->setVisible(visible);
+    if (!visible) return;
+
+    PROFILE_SCOPE("MainWindow::updatePreview", ProfileCategory::Render);
+
+    const QVector<QPointF> points = trajectoryCache.trace(*engine, angleSlider->value(), speedSlider->value(),
+                                                          clock.getSubStepDt());
+    QPainterPath path(points.first());
+    for (int i = 1; i < points.size(); ++i) {
+        path.lineTo(points[i]);
+    }
+    previewItem->setPath(path);
+}
+
+// Barra del historial: va del cuadro mas antiguo guardado al ultimo y solo
+// se puede mover mientras nada esta en vuelo ni pensando
+void MainWindow::updateHistoryControls()
+{
+    const bool idle = !timer->isActive() && threadedShot == 0 && !aiWatcher->isRunning();
+
+    historySlider->blockSignals(true);
+    historySlider->setRange(history.getFirstFrame(), history.getLastFrame());
+    historySlider->setValue(history.getCurrentFrame());
+    historySlider->blockSignals(false);
+    historySlider->setEnabled(idle);
+
+    const StateHistory::FrameInfo info = history.getFrameInfo(history.getCurrentFrame());
+    historyLabel->setText(QString("Turno %1, paso %2").arg(info.turn).arg(info.step));
+
+    // Un vuelo detenido a medias, o el turno de la computadora tras volver atras
+    resumeButton->setEnabled(idle && !engine->isGameOver() && (engine->hasActiveProjectiles() || isAiTurn()));
+}
+
+void MainWindow::seekHistory(int frame)
+{
+    if (timer->isActive() || threadedShot != 0 || aiWatcher->isRunning()) return;
+    if (!history.seek(*engine, frame)) return;
+
+    syncSceneWithEngine();
+    updateHistoryControls();
+    updateHitMap();
+    updatePreview();
+}
+
+void MainWindow::resumeFromHistory()
+{
+    if (engine->hasActiveProjectiles()) {
+        // El vuelo sigue desde el paso elegido; lo que venia despues se
+        // descarta al grabar el primer paso
+        if (history.getCurrentFrame() != history.getLastFrame()) replayRestart = true;
+
+        for (int p = 0; p < engine->getProjectileCount(); ++p) {
+            previousProjectilePos[p] = engine->getProjectile(p).getPosition();
+        }
+        clock.reset();
+        frameTimer.start();
+
+        launchButton->setEnabled(false);
+        threadCheck->setEnabled(false);
+        statusLabel->setText("Proyectil en vuelo...");
+
+        timer->start();
+        updateHistoryControls();
+        updateHitMap();
+        updatePreview();
+    } else if (isAiTurn()) {
+        startAiTurn();
+    }
+}
+
+// Despues de volver a un paso del historial el motor cambio sin eventos:
+// se recorren todos los bloques y se dibuja el proyectil donde quedo
+void MainWindow::syncSceneWithEngine()
+{
+    auto syncBlocks = [](const QVector<Infrastructure>& blocks, QVector<QGraphicsRectItem*>& items,
+                         QVector<QGraphicsTextItem*>& labels) {
+        for (int i = 0; i < blocks.size() && i < items.size(); ++i) {
+            const bool standing = !blocks[i].isDestroyed();
+            items[i]->setVisible(standing);
+            labels[i]->setVisible(standing);
+            labels[i]->setPlainText(QString::number((int)blocks[i].getResistance()));
+        }
+    };
+    syncBlocks(engine->getPlayer1Infrastructure(), player1InfraItems, resistanceLabels1);
+    syncBlocks(engine->getPlayer2Infrastructure(), player2InfraItems, resistanceLabels2);
+
+    for (int i = 0; i < projectileItems.size(); ++i) {
+        const bool shown = i < engine->getProjectileCount() && engine->getProjectile(i).isActive();
+        if (shown) {
+            const QPointF pos = engine->getProjectile(i).getPosition();
+            projectileItems[i]->setPos(pos.x() - 8, pos.y() - 8);
+        }
+        projectileItems[i]->setVisible(shown);
+    }
+
+    const bool flying = engine->hasActiveProjectiles();
+    playerLabel->setText(QString("Turno: Jugador %1").arg(engine->getCurrentPlayer()));
+    if (engine->isGameOver()) {
+        statusLabel->setText("Juego terminado");
+        updateBouncesLabel(bouncesLeft = -1);
+    } else {
+        statusLabel->setText(flying ? "Vuelo detenido: presiona Reanudar"
+                                    : "Ajusta el ángulo y velocidad, luego presiona LANZAR");
+        const Projectile* first = engine->getActiveProjectile();
+        bouncesLeft = (flying && first) ? std::max(0, 3 - first->getBounceCount()) : 3;
+        updateBouncesLabel(bouncesLeft);
+    }
+    launchButton->setEnabled(!engine->isGameOver() && !flying && !isAiTurn());
+}
+
+void MainWindow::saveReplay()
+{
+    QString path = QFileDialog::getSaveFileName(this, "Guardar repetición", QString(),
+                                                "Repeticiones (*.l5r)");
+    if (path.isEmpty()) return;
+
+    if (!replay.saveToFile(path)) {
+        QMessageBox::warning(this, "Repetición", "No se pudo guardar " + path);
+    }
+}
+
+void MainWindow::updateAngleLabel(int value)
+{
+    angleLabel->setText(QString("Ángulo: %1°").arg(value));
+}
+
+void MainWindow::updateSpeedLabel(int value)
+{
+    speedLabel->setText(QString("Velocidad: %1").arg(value));
+}
+
+void MainWindow::updateTimeScale(int index)
+{
+    clock.setTimeScale(timeScaleCombo->itemData(index).toDouble());
+    simulationThread.setTimeScale(clock.getTimeScale());
+}
+
+void MainWindow::processEngineEvents()
+{
+    PROFILE_SCOPE("MainWindow::processEngineEvents", ProfileCategory::Render);
+
+    // Solo se tocan los elementos afectados por lo que ocurrio desde el
+    // ultimo cuadro; sin eventos no se recorre nada
+    GameEvent event;
+    while (engineEvents.pop(event)) {
+        applyEngineEvent(event);
+    }
+}
+
+void MainWindow::applyEngineEvent(const GameEvent& event)
+{
+    telemetry.record(event);
+
+    switch (event.type) {
+    case GameEventType::Launch:
+        bouncesLeft = 3;
+        updateBouncesLabel(bouncesLeft);
+        break;
+
+    // Con una andanada el contador sigue al primer proyectil; se toma del
+    // evento porque en una esquina hay dos WallBounce y un solo rebote
+    case GameEventType::WallBounce:
+        if (event.projectile == 0) {
+            updateBouncesLabel(bouncesLeft = std::max(0, 3 - event.bounces));
+        }
+        break;
+
+    case GameEventType::InfrastructureHit: {
+        if (event.projectile == 0) {
+            updateBouncesLabel(bouncesLeft = std::max(0, 3 - event.bounces));
+        }
+
+        // La resistencia viaja en el evento: con la simulacion en otro
+        // hilo el motor de la interfaz todavia no tiene el golpe
+        QVector<QGraphicsTextItem*>& labels = (event.player == 1) ? resistanceLabels1 : resistanceLabels2;
+        if (event.index < labels.size()) {
+            labels[event.index]->setPlainText(QString::number((int)event.resistance));
+        }
+        break;
+    }
+
+    case GameEventType::BlockDestroyed: {
+        QVector<QGraphicsRectItem*>& items = (event.player == 1) ? player1InfraItems : player2InfraItems;
+        QVector<QGraphicsTextItem*>& labels = (event.player == 1) ? resistanceLabels1 : resistanceLabels2;
+        if (event.index < items.size()) {
+            items[event.index]->setVisible(false);
+            labels[event.index]->setVisible(false);
+        }
+        break;
+    }
+
+    case GameEventType::TurnSwitch:
+        playerLabel->setText(QString("Turno: Jugador %1").arg(event.player));
+        statusLabel->setText("Ajusta el ángulo y velocidad, luego presiona LANZAR");
+        bouncesLeft = 3;
+        updateBouncesLabel(bouncesLeft);
+        break;
+
+    case GameEventType::GameOver:
+        statusLabel->setText("Juego terminado");
+        updateBouncesLabel(-1);
+        break;
+
+    case GameEventType::RivalHit:
+        break;
+    }
+}
+
+void MainWindow::updateBouncesLabel(int bouncesLeft)
+{
+    // El texto y sobre todo la hoja de estilo solo se tocan si cambia el valor
+    if (bouncesLeft == shownBouncesLeft) return;
+    PROFILE_SCOPE("MainWindow::updateBouncesLabel", ProfileCategory::Render);
+    shownBouncesLeft = bouncesLeft;
+
+    if (bouncesLeft < 0) {
+        bouncesLabel->setText("Rebotes restantes: -");
+        return;
+    }
+
+    bouncesLabel->setText(QString("Rebotes restantes: %1").arg(bouncesLeft));
+
+    // Cambiar color según rebotes restantes
+    if (bouncesLeft == 1) {
+        bouncesLabel->setStyleSheet("font-weight: bold; font-size: 14px; color: #FF0000;");
+    } else if (bouncesLeft == 2) {
+        bouncesLabel->setStyleSheet("font-weight: bold; font-size: 14px; color: #FF6347;");
+    } else {
+        bouncesLabel->setStyleSheet("font-weight: bold; font-size: 14px; color: #32CD32;");
+    }
+}
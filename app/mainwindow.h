@@ -0,0 +1,192 @@
+#ifndef MAINWINDOW_H
+#define MAINWINDOW_H
+
+#include <QMainWindow>
+#include <QGraphicsScene>
+#include <QGraphicsView>
+#include <QGraphicsTextItem>
+#include <QGraphicsRectItem>
+#include <QGraphicsEllipseItem>
+#include <QGraphicsPathItem>
+#include <QTimer>
+#include <QSlider>
+#include <QLabel>
+#include <QPushButton>
+#include <QComboBox>
+#include <QCheckBox>
+#include <QSpinBox>
+#include <QElapsedTimer>
+#include <QFutureWatcher>
+#include <QHash>
+#include <QList>
+#include <atomic>
+#include "gameengine.h"
+#include "hitmap.h"
+#include "level.h"
+#include "profiler.h"
+#include "replay.h"
+#include "shotplanner.h"
+#include "simulationclock.h"
+#include "simulationthread.h"
+#include "statehistory.h"
+#include "telemetry.h"
+#include "trajectorycache.h"
+
+class MainWindow : public QMainWindow
+{
+    Q_OBJECT
+
+    // Mide renderScene y processEngineEvents (benchmark/renderbenchmark.cpp)
+    friend class RenderBenchmark;
+
+public:
+    MainWindow(QWidget *parent = nullptr);
+    ~MainWindow();
+
+    // Graba todos los eventos del motor en path (engine/telemetry.h), una
+    // partida por nivel abierto; false si no se pudo crear el archivo
+    bool openTelemetry(const QString& path);
+
+private slots:
+    void updateGame();
+    void launchProjectile();
+    void updateAngleLabel(int value);
+    void updateSpeedLabel(int value);
+    void updateTimeScale(int index);
+    void updateAiPlayer(bool enabled);
+    void aiShotReady();
+    void saveReplay();
+    void loadLevel();
+    void updateProfiling(bool enabled);
+    void toggleTrace(bool recording);
+    void updateHitMap();
+    void hitMapBatchReady();
+    void updatePreview();
+    void seekHistory(int frame);
+    void resumeFromHistory();
+
+private:
+    QGraphicsScene *scene;
+    QGraphicsView *view;
+    QTimer *timer;
+
+    QSlider *angleSlider;
+    QSlider *speedSlider;
+    QPushButton *launchButton;
+    QPushButton *saveReplayButton;
+    QPushButton *loadLevelButton;
+    QCheckBox *profileCheck;    // nullptr si las sondas no se compilaron
+    QPushButton *traceButton;
+    QLabel *profileOverlay;     // FPS y tiempos por cuadro sobre la escena
+    int overlayFrames;
+    QLabel *angleLabel;
+    QLabel *speedLabel;
+    QLabel *playerLabel;
+    QLabel *statusLabel;
+    QLabel *bouncesLabel;  // NUEVO: Etiqueta para mostrar rebotes restantes
+    QComboBox *timeScaleCombo;
+    QCheckBox *aiCheck;
+    QSpinBox *volleySpin;
+    QCheckBox *threadCheck;
+    QCheckBox *hitMapCheck;
+    QCheckBox *previewCheck;
+    QSlider *historySlider;
+    QLabel *historyLabel;
+    QPushButton *resumeButton;
+
+    GameEngine *engine;
+
+    // La fisica avanza en pasos fijos segun el tiempo real medido entre
+    // cuadros; el proyectil se dibuja interpolado entre los dos ultimos pasos
+    SimulationClock clock;
+    QElapsedTimer frameTimer;
+    QPointF previousProjectilePos[GameEngine::maxProjectiles];
+
+    // Con "Simular en otro hilo" el disparo avanza en simulationThread sobre
+    // una copia del motor; la interfaz solo lee sus instantaneos y eventos
+    // y recoge el motor al terminar. threadedShot es el numero del disparo
+    // en curso en el hilo, 0 si se simula en la interfaz.
+    SimulationThread simulationThread;
+    quint64 threadedShot;
+
+    // Escenario inicial y disparos de la partida, para guardarla
+    Replay replay;
+
+    // Cada paso y cada turno de la partida, para volver atras con
+    // historySlider. Al seguir jugando desde un paso anterior se descarta lo
+    // que venia despues y la repeticion empieza de nuevo desde ahi (si se
+    // sigue un vuelo a medias, desde el turno siguiente: replayRestart).
+    StateHistory history;
+    bool replayRestart;
+
+    // Registro de eventos para analizar las partidas fuera del juego; se
+    // alimenta desde applyEngineEvent, siempre en el hilo de la interfaz
+    TelemetryLog telemetry;
+    quint32 telemetryMatch;
+
+    // Un elemento por lugar del arreglo de proyectiles del motor, creados
+    // una vez y ocultos cuando no estan en vuelo
+    QVector<QGraphicsEllipseItem*> projectileItems;
+    // Un elemento por bloque con el mismo indice que en el motor; los
+    // bloques destruidos se ocultan en vez de reconstruir la escena
+    QVector<QGraphicsRectItem*> player1InfraItems;
+    QVector<QGraphicsRectItem*> player2InfraItems;
+    QVector<QGraphicsTextItem*> resistanceLabels1;
+    QVector<QGraphicsTextItem*> resistanceLabels2;
+    int shownBouncesLeft;
+
+    // Eventos del motor pendientes de reflejar en la escena
+    GameEventRing engineEvents;
+    int bouncesLeft;
+
+    // Jugador 2 controlado por la computadora: la busqueda corre en el
+    // pool de hilos de Qt sobre una copia del motor
+    QFutureWatcher<PlannedShot> *aiWatcher;
+    std::atomic<bool> aiCancel;
+    static constexpr double aiTimeBudgetMs = 50.0;
+    static constexpr double volleySpread = 12.0;  // Abanico de la andanada en grados
+
+    // Mapa de golpes a la velocidad del slider: las tandas (de la rejilla
+    // gruesa a la fina) se simulan en el pool de hilos de Qt y se guardan
+    // por (estado de los bloques, velocidad), asi que volver a una
+    // velocidad ya vista lo muestra al instante. Mover un slider cancela la
+    // tanda en curso; lo ya calculado se conserva.
+    QFutureWatcher<QVector<HitSample>> *hitMapWatcher;
+    std::atomic<bool> hitMapCancel;
+    QHash<quint64, HitMap> hitMaps;
+    QList<quint64> hitMapOrder;  // De la mas antigua a la mas nueva
+    quint64 hitMapKey;           // Mapa de la tanda en curso
+    QVector<int> hitMapBatch;    // Indices de la tanda en curso
+    QVector<QGraphicsEllipseItem*> hitMapItems;  // Uno por muestra
+    static constexpr int hitMapCacheSize = 64;
+
+    // Vista previa punteada del disparo de los sliders: un solo elemento
+    // cuyo trazo se reemplaza, con los recorridos guardados en
+    // trajectoryCache mientras no cambie ninguna resistencia
+    TrajectoryCache trajectoryCache;
+    QGraphicsPathItem *previewItem;
+
+    void setupUI();
+    void setupGame(const Level& level);
+    void renderScene();
+    void processEngineEvents();
+    void applyEngineEvent(const GameEvent& event);
+    void fireShot(double angle, double speed, int count);
+    void updateThreadedShot();
+    void finishShot();
+    void updateProjectileItems(const RenderSnapshot& snapshot, double alpha);
+    void hideProjectileItems();
+    bool isAiTurn() const;
+    void startAiTurn();
+    void updateBouncesLabel(int bouncesLeft);
+    void updateProfileOverlay();
+    quint64 currentHitMapKey() const;
+    void startHitMapBatch(quint64 key);
+    void cancelHitMap();
+    void drawHitMap(const HitMap& map);
+    void hideHitMap();
+    void updateHistoryControls();
+    void syncSceneWithEngine();
+};
+
+#endif // MAINWINDOW_H
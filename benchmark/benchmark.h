@@ -0,0 +1,56 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "level.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Resultado de una medicion
+struct BenchmarkResult
+{
+    std::string name;
+    long long iterations = 0;
+    double nsPerOp = 0.0;
+    double stepsPerSecond = 0.0;  // 0 si la operacion no avanza la simulacion
+    double allocsPerOp = 0.0;     // Reservas de memoria del montón por operacion
+};
+
+// Ejecuta cada medicion con cada vez mas iteraciones hasta que tarda al
+// menos minTimeMs y guarda la ultima. Solo corre las mediciones cuyo
+// nombre contiene filter.
+class BenchmarkRunner
+{
+public:
+    BenchmarkRunner(double minTimeMs, const std::string& filter);
+
+    // body(n) hace n operaciones y devuelve los pasos de simulacion que
+    // avanzo (0 si no aplica). Lo que prepara la operacion va fuera de body.
+    void run(const std::string& name, const std::function<long long(long long)>& body);
+
+    bool matches(const std::string& name) const;
+    const std::vector<BenchmarkResult>& getResults() const { return results; }
+
+private:
+    double minTimeMs;
+    std::string filter;
+    std::vector<BenchmarkResult> results;
+};
+
+// Reservas del montón desde que empezo el programa (ver main.cpp)
+long long allocationCount();
+
+// Nivel de prueba con la cantidad de bloques indicada (repartidos entre
+// los dos jugadores); con 6 es el tablero original
+Level benchmarkLevel(int blocks);
+
+// Mediciones de la interfaz con la plataforma "offscreen" (renderbenchmark.cpp)
+void runRenderBenchmarks(BenchmarkRunner& runner, int& argc, char** argv);
+
+// Precision contra costo de cada integrador, paso y paso adaptativo
+// (integratorbenchmark.cpp). Imprime su propio CSV y al final la
+// combinacion mas barata cuyo error no pasa de maxError pixeles; devuelve
+// 2 si ninguna lo cumple.
+int runIntegratorBenchmarks(double minTimeMs, double maxError);
+
+#endif // BENCHMARK_H
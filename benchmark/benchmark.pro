@@ -0,0 +1,22 @@
+TEMPLATE = app
+TARGET = benchmark
+
+# La interfaz se mide con la plataforma "offscreen": no hace falta pantalla
+QT += core gui widgets concurrent
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+include(../engine/engine.pri)
+
+INCLUDEPATH += ../app
+
+SOURCES += \
+    integratorbenchmark.cpp \
+    main.cpp \
+    renderbenchmark.cpp \
+    ../app/mainwindow.cpp
+
+HEADERS += \
+    benchmark.h \
+    ../app/mainwindow.h
@@ -0,0 +1,189 @@
+#include "benchmark.h"
+#include "gameengine.h"
+#include "shotrunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+// Todos los pasos medidos dividen a samplePeriod, asi que las trayectorias
+// se comparan en los mismos instantes sin interpolar
+const double samplePeriod = 0.064;
+const double stepSizes[] = {0.004, 0.008, 0.016, 0.032, 0.064};
+const double referenceStep = 0.0005;
+
+// Despues del primer choque las trayectorias se separan enseguida (un
+// rebote un paso antes cambia todo lo que sigue), asi que el vuelo se
+// compara solo hasta el primer contacto y el choque por el punto de contacto
+struct Trajectory
+{
+    std::vector<QPointF> samples;  // Posicion cada samplePeriod hasta el primer contacto
+    QPointF contact;               // Donde rebota o se detiene por primera vez
+    int winner = 0;
+    int firstHitIndex = -1;
+};
+
+struct Shot
+{
+    double angle;
+    double speed;
+};
+
+// Primer choque (rebote, golpe a un bloque o al rival) que publica el
+// motor: con paso adaptativo ocurre en un subpaso, dentro de un update()
+struct ContactProbe
+{
+    bool touched = false;
+    QPointF position;
+
+    static void collect(void* context, const GameEvent& event)
+    {
+        ContactProbe* probe = static_cast<ContactProbe*>(context);
+        if (probe->touched || event.type == GameEventType::Launch) return;
+        probe->touched = true;
+        probe->position = event.position;
+    }
+};
+
+Trajectory trace(const GameEngine& base, const Shot& shot, double dt)
+{
+    GameEngine engine = base;
+    ContactProbe probe;
+    engine.setEventCallback(ContactProbe::collect, &probe);
+    engine.launchProjectile(engine.getCurrentPlayer(), shot.angle, shot.speed);
+
+    Trajectory trajectory;
+    const Projectile* projectile = engine.getActiveProjectile();
+    const int stepsPerSample = static_cast<int>(std::lround(samplePeriod / dt));
+    bool flying = true;
+    for (int step = 1; flying && step <= 100000; ++step) {
+        flying = engine.update(dt);
+        if (!probe.touched && step % stepsPerSample == 0) {
+            trajectory.samples.push_back(projectile->getPosition());
+        }
+    }
+
+    // Sin choques el contacto es donde salio del tablero
+    trajectory.contact = probe.touched ? probe.position : projectile->getPosition();
+    trajectory.winner = engine.isGameOver() ? engine.getWinner() : 0;
+    trajectory.firstHitIndex = engine.getShotStats().firstHitIndex;
+    return trajectory;
+}
+
+double distance(const QPointF& a, const QPointF& b)
+{
+    const QPointF d = a - b;
+    return std::sqrt(d.x() * d.x() + d.y() * d.y());
+}
+
+// Nanosegundos por disparo, repitiendo la lista hasta llegar a minTimeMs;
+// stepsPerShot queda con los update() promedio de cada disparo
+double timeShots(const GameEngine& base, const std::vector<Shot>& shots, double dt, double minTimeMs,
+                 double& stepsPerShot)
+{
+    typedef std::chrono::steady_clock Clock;
+    long long count = 0;
+    long long steps = 0;
+    Clock::time_point start = Clock::now();
+    double elapsedMs = 0.0;
+    do {
+        for (const Shot& shot : shots) {
+            GameEngine engine = base;
+            steps += runShot(engine, shot.angle, shot.speed, dt).steps;
+            count++;
+        }
+        elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    } while (elapsedMs < minTimeMs);
+
+    stepsPerShot = double(steps) / count;
+    return elapsedMs * 1e6 / count;
+}
+
+} // namespace
+
+int runIntegratorBenchmarks(double minTimeMs, double maxError)
+{
+    // Tablero original, jugador 1: tiros que caen al suelo, rebotan en las
+    // paredes, golpean bloques y alcanzan al rival
+    const GameEngine prototype = benchmarkLevel(6).createEngine();
+    std::vector<Shot> shots;
+    for (double angle = 10; angle <= 80; angle += 5) {
+        for (double speed = 100; speed <= 250; speed += 25) {
+            shots.push_back(Shot{angle, speed});
+        }
+    }
+
+    // Referencia: trayectoria exacta con colision continua y un paso muy fino
+    GameEngine referenceEngine = prototype;
+    referenceEngine.setIntegrator(Integrator::Exact);
+    referenceEngine.setContinuousCollision(true);
+    std::vector<Trajectory> reference;
+    for (const Shot& shot : shots) {
+        reference.push_back(trace(referenceEngine, shot, referenceStep));
+    }
+
+    std::printf("integrator,dt,adaptive,ns_per_shot,steps_per_shot,"
+                "max_flight_error_px,max_contact_error_px,mean_contact_error_px,outcome_mismatches\n");
+
+    const char* bestName = nullptr;
+    double bestStep = 0.0, bestTime = 0.0;
+    bool bestAdaptive = false;
+
+    for (int method = 0; method < integratorCount; ++method) {
+        const Integrator integrator = static_cast<Integrator>(method);
+        for (double dt : stepSizes) {
+            for (bool adaptive : {false, true}) {
+                GameEngine base = prototype;
+                base.setIntegrator(integrator);
+                base.setAdaptiveStep(adaptive);
+
+                double flightError = 0.0, maxContactError = 0.0, sumContactError = 0.0;
+                int mismatches = 0;
+                for (size_t i = 0; i < shots.size(); ++i) {
+                    const Trajectory trajectory = trace(base, shots[i], dt);
+                    const Trajectory& expected = reference[i];
+
+                    const size_t length = std::min(trajectory.samples.size(), expected.samples.size());
+                    for (size_t j = 0; j < length; ++j) {
+                        flightError = std::max(flightError, distance(trajectory.samples[j], expected.samples[j]));
+                    }
+
+                    const double contactError = distance(trajectory.contact, expected.contact);
+                    maxContactError = std::max(maxContactError, contactError);
+                    sumContactError += contactError;
+
+                    if (trajectory.winner != expected.winner ||
+                        trajectory.firstHitIndex != expected.firstHitIndex) {
+                        mismatches++;
+                    }
+                }
+
+                double stepsPerShot = 0.0;
+                const double nsPerShot = timeShots(base, shots, dt, minTimeMs, stepsPerShot);
+                std::printf("%s,%.3f,%d,%.1f,%.1f,%.4f,%.3f,%.3f,%d\n", integratorName(integrator), dt,
+                            adaptive ? 1 : 0, nsPerShot, stepsPerShot, flightError, maxContactError,
+                            sumContactError / shots.size(), mismatches);
+                std::fflush(stdout);
+
+                if (flightError <= maxError && maxContactError <= maxError && (!bestName || nsPerShot < bestTime)) {
+                    bestName = integratorName(integrator);
+                    bestStep = dt;
+                    bestAdaptive = adaptive;
+                    bestTime = nsPerShot;
+                }
+            }
+        }
+    }
+
+    if (!bestName) {
+        std::fprintf(stderr, "Ninguna combinacion queda dentro de %.3f px\n", maxError);
+        return 2;
+    }
+    std::fprintf(stderr, "Mas barata con error <= %.3f px: %s, dt %.3f%s (%.1f ns/disparo)\n",
+                 maxError, bestName, bestStep, bestAdaptive ? ", paso adaptativo" : "", bestTime);
+    return 0;
+}
@@ -0,0 +1,507 @@
+// Mediciones de rendimiento del motor y de la interfaz. Cada medicion
+// imprime una fila CSV con el tiempo por operacion, los pasos de
+// simulacion por segundo y las reservas de memoria por operacion, para
+// comparar una compilacion con otra (--baseline marca las que empeoraron).
+// Con --integrators mide en cambio la precision y el costo de los
+// integradores de la fisica por pasos.
+
+#include "autoaim.h"
+#include "benchmark.h"
+#include "gameengine.h"
+#include "shotrunner.h"
+#include "statehistory.h"
+#include "telemetry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <new>
+#include <sstream>
+
+// Contador de reservas del montón. Con glibc se cuentan malloc, calloc y
+// realloc (asi entran tambien los contenedores de Qt, que no usan new); en
+// otras plataformas solo operator new.
+static std::atomic<long long> allocations(0);
+
+long long allocationCount()
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* pointer, size_t size);
+
+void* malloc(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t count, size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void* realloc(void* pointer, size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(pointer, size);
+}
+}
+#else
+void* operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+#endif
+
+typedef std::chrono::steady_clock BenchmarkClock;
+
+// Evita que el compilador descarte los resultados medidos
+static volatile long long sink;
+
+BenchmarkRunner::BenchmarkRunner(double minTimeMs, const std::string& filter)
+    : minTimeMs(minTimeMs), filter(filter)
+{
+}
+
+bool BenchmarkRunner::matches(const std::string& name) const
+{
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+void BenchmarkRunner::run(const std::string& name, const std::function<long long(long long)>& body)
+{
+    if (!matches(name)) return;
+
+    // Una pasada de calentamiento y despues se duplica hasta llegar al tiempo minimo
+    body(1);
+
+    long long iterations = 1;
+    for (;;) {
+        long long allocationsBefore = allocationCount();
+        BenchmarkClock::time_point start = BenchmarkClock::now();
+        long long steps = body(iterations);
+        std::chrono::duration<double> elapsed = BenchmarkClock::now() - start;
+        long long allocated = allocationCount() - allocationsBefore;
+
+        double seconds = elapsed.count();
+        if (seconds * 1000.0 >= minTimeMs || iterations >= (1LL << 40)) {
+            BenchmarkResult result;
+            result.name = name;
+            result.iterations = iterations;
+            result.nsPerOp = seconds * 1e9 / iterations;
+            result.stepsPerSecond = (steps > 0 && seconds > 0) ? steps / seconds : 0.0;
+            result.allocsPerOp = double(allocated) / iterations;
+            results.push_back(result);
+
+            std::printf("%s,%lld,%.2f,%.0f,%.3f\n", name.c_str(), result.iterations,
+                        result.nsPerOp, result.stepsPerSecond, result.allocsPerOp);
+            std::fflush(stdout);
+            return;
+        }
+
+        // Estimar cuantas iteraciones faltan, sin crecer mas de 10 veces
+        double factor = (seconds > 0) ? 1.2 * minTimeMs / (seconds * 1000.0) : 10.0;
+        iterations = static_cast<long long>(iterations * std::max(2.0, std::min(10.0, factor)));
+    }
+}
+
+Level benchmarkLevel(int blocks)
+{
+    Level level;
+    if (blocks <= 6) return level;
+
+    // Bloques de 12x12 en una rejilla de celdas de 16 en el campo de cada
+    // jugador (reflejado para el jugador 2); la arena crece con la rejilla
+    const int perPlayer = blocks / 2;
+    const int cell = 16;
+    const int rows = std::max(1, static_cast<int>(std::ceil(std::sqrt(perPlayer / 2.0))));
+    const int columns = (perPlayer + rows - 1) / rows;
+    const double fieldLeft = 120, fieldTop = 250;
+
+    level.width = 2 * (fieldLeft + columns * cell + 30);
+    level.floorY = fieldTop + rows * cell;
+    level.height = level.floorY + 50;
+    level.cannonPositions[1] = QPointF(level.width - 35, 175);
+
+    QRectF zone(fieldLeft + columns * cell / 2 - 30, level.floorY - 110, 60, 110);
+    level.rivalZones[0] = zone;
+    level.rivalZones[1] = QRectF(level.width - zone.right(), zone.top(), zone.width(), zone.height());
+
+    level.blocks[0].clear();
+    level.blocks[1].clear();
+    for (int i = 0; i < perPlayer; ++i) {
+        double x = fieldLeft + (i % columns) * cell + 2;
+        double y = fieldTop + (i / columns) * cell + 2;
+        level.blocks[0].append(Infrastructure(x, y, 12, 12, 100));
+        level.blocks[1].append(Infrastructure(level.width - x - 12, y, 12, 12, 100));
+    }
+    return level;
+}
+
+static void runCollisionBenchmarks(BenchmarkRunner& runner)
+{
+    const Infrastructure block(170, 280, 55, 270, 200);
+
+    // Centros repartidos alrededor del bloque: la mitad tocan y la mitad no
+    // (en el tipo de la fisica, scalar.h)
+    std::vector<Vec2> centers;
+    for (int i = 0; i < 1024; ++i) {
+        centers.push_back(toVec2(QPointF(150 + (i * 37) % 100, 260 + (i * 53) % 310)));
+    }
+    const Scalar radius = toScalar(8.0);
+
+    runner.run("infrastructure/checkCollision", [&](long long n) {
+        long long hits = 0;
+        for (long long i = 0; i < n; ++i) {
+            hits += block.checkCollision(centers[i & 1023], radius);
+        }
+        sink = hits;
+        return 0LL;
+    });
+
+    runner.run("infrastructure/getCollisionSide", [&](long long n) {
+        long long sides = 0;
+        for (long long i = 0; i < n; ++i) {
+            sides += block.getCollisionSide(centers[i & 1023], centers[(i + 1) & 1023]);
+        }
+        sink = sides;
+        return 0LL;
+    });
+
+    runner.run("projectile/update", [&](long long n) {
+        Projectile projectile(35, 175, 45, 150, 1.0, 1);
+        for (long long i = 0; i < n; ++i) {
+            if ((i & 4095) == 0) projectile = Projectile(35, 175, 45, 150, 1.0, 1);
+            projectile.update(0.016);
+        }
+        sink = static_cast<long long>(projectile.getPosition().x());
+        return n;
+    });
+}
+
+static void runEngineBenchmarks(BenchmarkRunner& runner, int blocks)
+{
+    const Level level = benchmarkLevel(blocks);
+    const std::string suffix = "/" + std::to_string(blocks);
+
+    // Disparos variados para no medir un unico recorrido
+    static const double shots[][2] = {
+        {10, 120}, {20, 120}, {30, 120}, {40, 120}, {50, 120}, {60, 120}, {70, 120}, {80, 120},
+        {10, 220}, {20, 220}, {30, 220}, {40, 220}, {50, 220}, {60, 220}, {70, 220}, {80, 220},
+    };
+    const int shotCount = sizeof(shots) / sizeof(shots[0]);
+
+    const char* modes[] = {"discrete", "continuous", "events"};
+    for (int mode = 0; mode < 3; ++mode) {
+        std::string name = std::string("shot/") + modes[mode] + suffix;
+        if (!runner.matches(name)) continue;
+
+        GameEngine base = level.createEngine();
+        base.setContinuousCollision(mode == 1);
+        base.setEventDriven(mode == 2);
+
+        // Cada disparo parte del escenario intacto, como en el planificador:
+        // se restaura la instantanea
+        GameEngine engine = base;
+        GameState start;
+        std::vector<double> startResistance;
+        base.snapshot(start, startResistance);
+
+        runner.run(name, [&](long long n) {
+            long long steps = 0;
+            for (long long i = 0; i < n; ++i) {
+                if (!engine.restore(start, startResistance.data())) engine = base;
+                const double* shot = shots[i % shotCount];
+                steps += runShot(engine, shot[0], shot[1]).steps;
+            }
+            return steps;
+        });
+    }
+
+    // Punteria analitica a un bloque enemigo: parabola cerrada mas los
+    // pasos de Newton contra el motor
+    std::string name = "aim/block" + suffix;
+    if (runner.matches(name)) {
+        GameEngine engine = level.createEngine();
+        runner.run(name, [&](long long n) {
+            long long found = 0;
+            for (long long i = 0; i < n; ++i) {
+                found += aimAtBlock(engine, 0, 300).size();
+            }
+            sink = found;
+            return 0LL;
+        });
+    }
+
+    // La comprobacion de victoria corre en cada cambio de turno
+    name = "victory/switchTurn" + suffix;
+    if (runner.matches(name)) {
+        GameEngine engine = level.createEngine();
+        runner.run(name, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                engine.switchTurn();
+            }
+            sink = engine.getCurrentPlayer();
+            return 0LL;
+        });
+    }
+}
+
+// Historial para retroceder: una partida de disparos alternados sin grabar
+// y grabando cada paso (la diferencia es lo que agrega el historial), y
+// volver a pasos salteados de la partida grabada. La memoria del
+// historial va por stderr.
+static void runHistoryBenchmarks(BenchmarkRunner& runner, int blocks)
+{
+    const Level level = benchmarkLevel(blocks);
+    const std::string suffix = "/" + std::to_string(blocks);
+    const double dt = 0.016;
+
+    auto play = [dt](GameEngine& engine, StateHistory* history) {
+        if (history) history->begin(engine);
+        long long steps = 0;
+        for (int shot = 0; shot < 16 && !engine.isGameOver(); ++shot) {
+            engine.launchProjectile(engine.getCurrentPlayer(), 15 + 5 * shot, 120 + 10 * (shot % 8));
+            if (history) history->recordInput(engine);
+            while (engine.update(dt)) {
+                if (history) history->recordStep(engine, dt);
+                steps++;
+            }
+            if (history) history->recordStep(engine, dt);
+            if (!engine.isGameOver()) {
+                engine.switchTurn();
+                if (history) history->recordInput(engine);
+            }
+        }
+        return steps;
+    };
+
+    const GameEngine base = level.createEngine();
+    for (bool record : {false, true}) {
+        std::string name = std::string(record ? "history/record" : "history/play") + suffix;
+        if (!runner.matches(name)) continue;
+
+        StateHistory history;
+        runner.run(name, [&](long long n) {
+            long long steps = 0;
+            for (long long i = 0; i < n; ++i) {
+                GameEngine engine = base;
+                steps += play(engine, record ? &history : nullptr);
+            }
+            return steps;
+        });
+    }
+
+    std::string name = "history/seek" + suffix;
+    if (runner.matches(name)) {
+        GameEngine engine = base;
+        StateHistory history;
+        play(engine, &history);
+        const int frames = history.getLastFrame() + 1;
+        std::fprintf(stderr, "%s: %d cuadros, %d completos, %zu bytes\n", name.c_str(), frames,
+                     history.getKeyframeCount(), history.getBytes());
+
+        runner.run(name, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                history.seek(engine, static_cast<int>((i * 7919) % frames));
+            }
+            sink = engine.getShotStats().steps;
+            return 0LL;
+        });
+    }
+}
+
+// Lo que agrega el registro de telemetria por evento en el hilo que simula;
+// el hilo que escribe el archivo corre mientras tanto
+static void runTelemetryBenchmarks(BenchmarkRunner& runner)
+{
+    const char* name = "telemetry/record";
+    if (!runner.matches(name)) return;
+
+    const QString path = QString::fromLocal8Bit("benchmark-telemetria.l5t");
+    TelemetryLog log;
+    if (!log.open(path, 0.5, 1.0)) {
+        std::fprintf(stderr, "No se pudo crear el registro de telemetria\n");
+        return;
+    }
+
+    GameEvent event;
+    event.type = GameEventType::InfrastructureHit;
+    event.player = 2;
+    event.index = 1;
+    event.side = 0;
+    event.damage = 50.0;
+    event.resistance = 150.0;
+    event.position = QPointF(612, 291);
+    event.velocity = QPointF(130, -24);
+
+    runner.run(name, [&](long long n) {
+        for (long long i = 0; i < n; ++i) {
+            event.step = static_cast<int>(i);
+            log.record(event);
+        }
+        return 0LL;
+    });
+
+    log.close();
+    QFile::remove(path);
+    if (log.getDropped() > 0) {
+        std::fprintf(stderr, "%s: %lld eventos descartados con la cola llena\n", name, log.getDropped());
+    }
+}
+
+// Compara con un CSV de una compilacion anterior; devuelve cuantas
+// mediciones empeoraron mas de tolerance (en porcentaje) o reservan mas
+static int compareWithBaseline(const std::vector<BenchmarkResult>& results, const char* path, double tolerance)
+{
+    std::ifstream file(path);
+    if (!file) {
+        std::fprintf(stderr, "No se pudo abrir %s\n", path);
+        return -1;
+    }
+
+    std::map<std::string, BenchmarkResult> baseline;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        BenchmarkResult result;
+        std::string value;
+        if (!std::getline(fields, result.name, ',')) continue;
+        if (!std::getline(fields, value, ',')) continue;
+        result.iterations = std::atoll(value.c_str());
+        if (!std::getline(fields, value, ',')) continue;
+        result.nsPerOp = std::atof(value.c_str());
+        if (!std::getline(fields, value, ',')) continue;
+        result.stepsPerSecond = std::atof(value.c_str());
+        if (!std::getline(fields, value, ',')) continue;
+        result.allocsPerOp = std::atof(value.c_str());
+        if (result.iterations > 0) baseline[result.name] = result;
+    }
+
+    int regressions = 0;
+    for (const BenchmarkResult& result : results) {
+        auto previous = baseline.find(result.name);
+        if (previous == baseline.end()) continue;
+
+        double change = 100.0 * (result.nsPerOp / previous->second.nsPerOp - 1.0);
+        bool slower = change > tolerance;
+        bool allocates = result.allocsPerOp > previous->second.allocsPerOp + 0.01;
+        if (slower || allocates) {
+            regressions++;
+            std::fprintf(stderr, "EMPEORA %s: %.2f -> %.2f ns/op (%+.1f%%), %.3f -> %.3f reservas/op\n",
+                         result.name.c_str(), previous->second.nsPerOp, result.nsPerOp, change,
+                         previous->second.allocsPerOp, result.allocsPerOp);
+        }
+    }
+
+    std::fprintf(stderr, "%d mediciones empeoraron respecto de %s\n", regressions, path);
+    return regressions;
+}
+
+static void printUsage(const char* program)
+{
+    std::fprintf(stderr,
+                 "Uso: %s [opciones]\n"
+                 "\n"
+                 "Imprime una fila CSV por medicion:\n"
+                 "benchmark,iterations,ns_per_op,steps_per_s,allocs_per_op\n"
+                 "\n"
+                 "Opciones:\n"
+                 "  --min-time <ms>     Tiempo minimo de cada medicion (por defecto 200)\n"
+                 "  --filter <texto>    Solo las mediciones cuyo nombre lo contiene\n"
+                 "  --no-render         Omitir las mediciones de la interfaz\n"
+                 "  --baseline <csv>    Comparar con la salida de otra compilacion\n"
+                 "  --tolerance <%%>     Diferencia de tiempo tolerada (por defecto 10)\n"
+                 "  --integrators       Medir precision y costo de los integradores (otro CSV)\n"
+                 "  --max-error <px>    Con --integrators, error tolerado (por defecto 4)\n"
+                 "  --help              Mostrar esta ayuda\n",
+                 program);
+}
+
+int main(int argc, char *argv[])
+{
+    double minTimeMs = 200.0;
+    std::string filter;
+    bool render = true;
+    const char* baselinePath = nullptr;
+    double tolerance = 10.0;
+    bool integrators = false;
+    double maxError = 4.0;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--min-time") == 0 && i + 1 < argc) {
+            minTimeMs = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (std::strcmp(argv[i], "--baseline") == 0 && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            tolerance = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-error") == 0 && i + 1 < argc) {
+            maxError = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--integrators") == 0) {
+            integrators = true;
+        } else if (std::strcmp(argv[i], "--no-render") == 0) {
+            render = false;
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (minTimeMs <= 0) {
+        std::fprintf(stderr, "--min-time debe ser positivo\n");
+        return 1;
+    }
+
+    if (integrators) {
+        return runIntegratorBenchmarks(minTimeMs, maxError);
+    }
+
+    BenchmarkRunner runner(minTimeMs, filter);
+    std::printf("benchmark,iterations,ns_per_op,steps_per_s,allocs_per_op\n");
+
+    runCollisionBenchmarks(runner);
+    for (int blocks : {6, 1000, 100000}) {
+        runEngineBenchmarks(runner, blocks);
+        runHistoryBenchmarks(runner, blocks);
+    }
+    runTelemetryBenchmarks(runner);
+    if (render) {
+        runRenderBenchmarks(runner, argc, argv);
+    }
+
+    if (baselinePath) {
+        int regressions = compareWithBaseline(runner.getResults(), baselinePath, tolerance);
+        if (regressions < 0) return 1;
+        if (regressions > 0) return 2;
+    }
+    return 0;
+}
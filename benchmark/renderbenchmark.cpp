@@ -0,0 +1,63 @@
+#include "benchmark.h"
+#include "mainwindow.h"
+#include <QApplication>
+
+// Acceso a las partes privadas de MainWindow que se miden (declarada amiga
+// en mainwindow.h)
+class RenderBenchmark
+{
+public:
+    static void run(BenchmarkRunner& runner, int& argc, char** argv);
+
+private:
+    static void silentMessages(QtMsgType, const QMessageLogContext&, const QString&) {}
+};
+
+void RenderBenchmark::run(BenchmarkRunner& runner, int& argc, char** argv)
+{
+    if (!runner.matches("render/")) return;
+
+    // Sin pantalla: la escena se construye igual pero no se muestra
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    QtMessageHandler previousHandler = qInstallMessageHandler(silentMessages);
+
+    MainWindow window;
+
+    for (int blocks : {6, 1000}) {
+        const std::string suffix = "/" + std::to_string(blocks);
+        window.setupGame(benchmarkLevel(blocks));
+
+        // Escena completa: suelo, cañones, rivales y un elemento y una
+        // etiqueta por bloque
+        runner.run("render/renderScene" + suffix, [&](long long n) {
+            for (long long i = 0; i < n; ++i) {
+                window.renderScene();
+            }
+            return 0LL;
+        });
+
+        // Actualizar la resistencia de un bloque golpeado, como en cada cuadro
+        const int count = window.engine->getPlayer2Infrastructure().size();
+        runner.run("render/processEngineEvents" + suffix, [&](long long n) {
+            GameEvent event;
+            event.type = GameEventType::InfrastructureHit;
+            event.player = 2;
+            for (long long i = 0; i < n; ++i) {
+                event.index = static_cast<int>(i % count);
+                window.engineEvents.push(event);
+                window.processEngineEvents();
+            }
+            return 0LL;
+        });
+    }
+
+    qInstallMessageHandler(previousHandler);
+}
+
+void runRenderBenchmarks(BenchmarkRunner& runner, int& argc, char** argv)
+{
+    RenderBenchmark::run(runner, argc, argv);
+}
@@ -0,0 +1,270 @@
+#include "autoaim.h"
+#include "ballistics.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// Resultado de simular un angulo
+struct Trial
+{
+    bool hit = false;       // Alcanzo el objetivo
+    bool crossed = false;   // Cruzo la vertical del centro en el sentido esperado
+    double residual = 0.0;  // Altura del cruce menos la del centro (y hacia abajo)
+};
+
+// Copia del escenario con el indice espacial ya construido, para que las
+// copias que se hacen de ella no lo vuelvan a construir
+GameEngine indexedCopy(const GameEngine& state)
+{
+    GameEngine copy(state);
+    copy.buildSpatialIndex();
+    return copy;
+}
+
+// Motor de trabajo que se reinicia desde la instantanea antes de cada intento
+class AimEvaluator
+{
+public:
+    AimEvaluator(const GameEngine& state, const QRectF& target, int targetBlock,
+                 double speed, const AimSettings& settings)
+        : base(indexedCopy(state)), engine(base), target(target), targetBlock(targetBlock), speed(speed),
+          settings(settings), player(state.getCurrentPlayer()), runs(0)
+    {
+        base.snapshot(start, startResistance);
+        path.reserve(1024);
+    }
+
+    // Simula angle y deja el recorrido hasta el golpe en path. direction es
+    // el sentido horizontal (+1 o -1) con el que se espera cruzar la
+    // vertical de aim; pasado el objetivo sin golpearlo se deja de simular.
+    Trial run(double angle, const QPointF& aim, int direction)
+    {
+        if (!engine.restore(start, startResistance.data())) {
+            engine = base;
+        }
+        runs++;
+
+        engine.launchProjectile(player, angle, speed);
+        const Projectile& projectile = *engine.getActiveProjectile();
+        const double passed = target.width() / 2 + projectile.getRadius();
+
+        Trial trial;
+        path.clear();
+        QPointF previous = projectile.getPosition();
+        for (int step = 0; step < 100000; ++step) {
+            const bool flying = engine.update(settings.dt);
+            const QPointF position = projectile.getPosition();
+            path.push_back(position);
+
+            if (!trial.crossed && (previous.x() - aim.x()) * (position.x() - aim.x()) <= 0 &&
+                (position.x() - previous.x()) * direction > 0) {
+                double f = (aim.x() - previous.x()) / (position.x() - previous.x());
+                trial.residual = previous.y() + f * (position.y() - previous.y()) - aim.y();
+                trial.crossed = true;
+            }
+            previous = position;
+
+            // Un bloque se alcanza si es el primero que golpea; la zona del
+            // rival, aunque antes rebote en algun bloque
+            const int firstHit = engine.getShotStats().firstHitIndex;
+            if (targetBlock >= 0 && firstHit >= 0) {
+                trial.hit = (firstHit == targetBlock);
+                break;
+            }
+            if (targetBlock < 0 && engine.isGameOver()) {
+                trial.hit = (engine.getWinner() == player);
+                break;
+            }
+            if (!flying) break;
+            if (trial.crossed && (position.x() - target.center().x()) * direction > passed) break;
+        }
+        return trial;
+    }
+
+    // Holgura del ultimo recorrido respecto de los demas bloques enemigos
+    double clearance() const
+    {
+        const double radius = Projectile().getRadius();
+        const double margin = settings.maxClearance + radius;
+        if (path.empty()) return settings.maxClearance;
+
+        double left = path.front().x(), right = left;
+        double top = path.front().y(), bottom = top;
+        for (const QPointF& p : path) {
+            left = std::min(left, p.x());
+            right = std::max(right, p.x());
+            top = std::min(top, p.y());
+            bottom = std::max(bottom, p.y());
+        }
+        const QRectF bounds(left - margin, top - margin, right - left + 2 * margin, bottom - top + 2 * margin);
+
+        const QVector<Infrastructure>& blocks =
+            (player == 1) ? base.getPlayer2Infrastructure() : base.getPlayer1Infrastructure();
+        double best = settings.maxClearance;
+        for (int i = 0; i < blocks.size(); ++i) {
+            if (i == targetBlock || blocks[i].isDestroyed()) continue;
+            const QRectF rect = blocks[i].getRect();
+            if (!rect.intersects(bounds)) continue;
+
+            for (const QPointF& p : path) {
+                double dx = std::max({rect.left() - p.x(), 0.0, p.x() - rect.right()});
+                double dy = std::max({rect.top() - p.y(), 0.0, p.y() - rect.bottom()});
+                best = std::min(best, std::sqrt(dx * dx + dy * dy) - radius);
+            }
+        }
+        return best;
+    }
+
+    int getRuns() const { return runs; }
+    int getPlayer() const { return player; }
+    double getSpeed() const { return speed; }
+
+private:
+    GameEngine base;
+    GameEngine engine;
+    GameState start;
+    std::vector<double> startResistance;
+    QRectF target;
+    int targetBlock;
+    double speed;
+    AimSettings settings;
+    int player;
+    int runs;
+    std::vector<QPointF> path;
+};
+
+// Angulo inicial de la parabola cerrada hacia un punto de mira
+struct Seed
+{
+    QPointF aim;
+    int crossing;  // Sentido horizontal con el que se cruza la vertical de aim
+    double angle;
+    bool wallBounce;
+    bool highArc;
+};
+
+// Corrige el angulo con pasos de Newton hasta que el motor confirma el
+// golpe y en ese caso agrega la solucion
+void refine(AimEvaluator& evaluator, const Seed& seed, const AimSettings& settings,
+            QVector<AimSolution>& solutions)
+{
+    // Derivada por diferencias: primero un intento vecino y despues
+    // secante con los dos ultimos
+    const QPointF& aim = seed.aim;
+    const int crossing = seed.crossing;
+    const int runsBefore = evaluator.getRuns();
+    double angle = seed.angle;
+    Trial trial = evaluator.run(angle, aim, crossing);
+    double previousAngle = angle;
+    Trial previous = trial;
+    for (int step = 0; !trial.hit && trial.crossed && step <= settings.newtonSteps; ++step) {
+        double next;
+        if (step == 0) {
+            next = angle + ((angle < 89.95) ? 0.05 : -0.05);
+        } else {
+            double slope = (trial.residual - previous.residual) / (angle - previousAngle);
+            if (slope == 0 || !std::isfinite(slope)) break;
+            next = angle - std::max(-5.0, std::min(5.0, trial.residual / slope));
+        }
+        next = std::max(0.0, std::min(90.0, next));
+        if (next == angle) break;
+
+        Trial nextTrial = evaluator.run(next, aim, crossing);
+        if (!nextTrial.hit && !nextTrial.crossed) break;
+        previousAngle = angle;
+        previous = trial;
+        angle = next;
+        trial = nextTrial;
+    }
+    if (!trial.hit) return;
+
+    // Varios puntos de mira pueden converger al mismo disparo
+    for (const AimSolution& other : solutions) {
+        if (std::abs(other.angle - angle) < 0.01) return;
+    }
+
+    AimSolution solution;
+    solution.angle = angle;
+    solution.speed = evaluator.getSpeed();
+    solution.clearance = evaluator.clearance();
+    solution.wallBounces = seed.wallBounce ? 1 : 0;
+    solution.highArc = seed.highArc;
+    solution.engineRuns = evaluator.getRuns() - runsBefore;
+    solutions.push_back(solution);
+}
+
+} // namespace
+
+QVector<AimSolution> solveAim(const GameEngine& state, const QRectF& target, int targetBlock,
+                              double speed, const AimSettings& settings)
+{
+    QVector<AimSolution> solutions;
+    if (state.isGameOver() || speed <= 0) return solutions;
+
+    const int player = state.getCurrentPlayer();
+    const int direction = (player == 1) ? 1 : -1;
+    const QPointF cannon = state.getCannonPosition(player);
+    const QPointF center = target.center();
+    const double radius = Projectile().getRadius();
+    const double g = Projectile::getGravity();
+
+    // Puntos de mira: el centro, el medio de la cara que da al cañon y el
+    // medio del techo del objetivo (los dos ultimos alcanzan mas lejos)
+    const QPointF aims[] = {
+        center,
+        QPointF(direction > 0 ? target.left() : target.right(), center.y()),
+        QPointF(center.x(), target.top()),
+    };
+
+    // Cada punto y sus reflejos en las paredes donde rebota el centro del
+    // proyectil: despues del rebote la trayectoria es la del reflejo
+    Seed seeds[3 * 3 * 2];
+    int seedCount = 0;
+    for (const QPointF& aim : aims) {
+        const double images[] = {aim.x(), 2 * (state.getBoxWidth() - radius) - aim.x(), 2 * radius - aim.x()};
+        for (int bounces = 0; bounces < 3; ++bounces) {
+            double angles[2];
+            const int count = ballistics::launchAngles(direction * (images[bounces] - cannon.x()),
+                                                       cannon.y() - aim.y(), speed, g, angles);
+            const int crossing = (bounces == 0) ? direction : -direction;
+
+            for (int k = 0; k < count; ++k) {
+                if (angles[k] < 0 || angles[k] > 90) continue;
+                seeds[seedCount++] = Seed{aim, crossing, angles[k], bounces > 0, k == 1};
+            }
+        }
+    }
+
+    // Las copias del motor solo se hacen si la parabola alcanza el objetivo
+    if (seedCount == 0) return solutions;
+
+    AimEvaluator evaluator(state, target, targetBlock, speed, settings);
+    for (int i = 0; i < seedCount; ++i) {
+        refine(evaluator, seeds[i], settings, solutions);
+    }
+
+    std::stable_sort(solutions.begin(), solutions.end(), [](const AimSolution& a, const AimSolution& b) {
+        if (a.clearance != b.clearance) return a.clearance > b.clearance;
+        if (a.wallBounces != b.wallBounces) return a.wallBounces < b.wallBounces;
+        return a.angle < b.angle;
+    });
+    return solutions;
+}
+
+QVector<AimSolution> aimAtRival(const GameEngine& state, double speed, const AimSettings& settings)
+{
+    const int rival = (state.getCurrentPlayer() == 1) ? 2 : 1;
+    return solveAim(state, state.getRivalZone(rival), -1, speed, settings);
+}
+
+QVector<AimSolution> aimAtBlock(const GameEngine& state, int index, double speed, const AimSettings& settings)
+{
+    const QVector<Infrastructure>& blocks = (state.getCurrentPlayer() == 1)
+        ? state.getPlayer2Infrastructure() : state.getPlayer1Infrastructure();
+    if (index < 0 || index >= blocks.size() || blocks[index].isDestroyed()) {
+        return QVector<AimSolution>();
+    }
+    return solveAim(state, blocks[index].getRect(), index, speed, settings);
+}
@@ -0,0 +1,47 @@
+#ifndef AUTOAIM_H
+#define AUTOAIM_H
+
+#include "gameengine.h"
+#include <QRectF>
+#include <QVector>
+
+// Parametros de la punteria automatica
+struct AimSettings
+{
+    double dt = 0.016;            // Paso con el que se simula cada intento
+    int newtonSteps = 4;          // Correcciones del angulo contra el motor
+    double maxClearance = 100.0;  // Holgura a partir de la cual ya no se distingue
+};
+
+// Disparo que alcanza el objetivo
+struct AimSolution
+{
+    double angle = 0.0;
+    double speed = 0.0;
+    double clearance = 0.0;  // Menor distancia del borde del proyectil a otro bloque enemigo
+                             // antes de llegar (hasta maxClearance; negativa si lo roza)
+    int wallBounces = 0;     // 0 = tiro directo, 1 = rebotando en una pared lateral
+    bool highArc = false;    // La solucion bombeada de la parabola
+    int engineRuns = 0;      // Simulaciones que costo refinarla y comprobarla
+};
+
+// Soluciones a velocidad speed para que el jugador actual de state alcance
+// target: la zona del rival (targetBlock = -1) o el bloque enemigo
+// targetBlock. Los angulos iniciales salen de la parabola cerrada desde el
+// cañon (ballistics::launchAngles), apuntando al centro de target y a sus
+// reflejos en las paredes laterales (que devuelven el proyectil sin perder
+// velocidad). Cada uno se simula en una copia del motor con sus rebotes y
+// modos de colision, y se corrige con pasos de Newton (secante) sobre la
+// altura a la que cruza el centro hasta que golpea o se agotan los pasos.
+// Solo se devuelven las que el motor confirma, de mayor a menor holgura.
+// state no se modifica.
+QVector<AimSolution> solveAim(const GameEngine& state, const QRectF& target, int targetBlock,
+                              double speed, const AimSettings& settings = AimSettings());
+
+// Atajos: la zona del rival del jugador actual y un bloque suyo
+QVector<AimSolution> aimAtRival(const GameEngine& state, double speed,
+                                const AimSettings& settings = AimSettings());
+QVector<AimSolution> aimAtBlock(const GameEngine& state, int index, double speed,
+                                const AimSettings& settings = AimSettings());
+
+#endif // AUTOAIM_H
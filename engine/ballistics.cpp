@@ -0,0 +1,206 @@
+#include "ballistics.h"
+#include <algorithm>
+#include <cmath>
+
+namespace ballistics {
+
+int launchAngles(double dx, double rise, double speed, double g, double angles[2])
+{
+    if (dx <= 0 || speed <= 0) return 0;
+
+    // tan(a) = (v^2 -+ sqrt(v^4 - g (g dx^2 + 2 rise v^2))) / (g dx)
+    const double v2 = speed * speed;
+    const double discriminant = v2 * v2 - g * (g * dx * dx + 2 * rise * v2);
+    if (discriminant < 0) return 0;
+
+    const double root = std::sqrt(discriminant);
+    angles[0] = std::atan2(v2 - root, g * dx) * 180.0 / M_PI;
+    angles[1] = std::atan2(v2 + root, g * dx) * 180.0 / M_PI;
+    return (root == 0) ? 1 : 2;
+}
+
+double firstTimeAtX(double x0, double vx, double level, double minT, double maxT)
+{
+    if (vx == 0) return -1;
+
+    double t = (level - x0) / vx;
+    return (t > minT && t <= maxT) ? t : -1;
+}
+
+double firstTimeAtY(double y0, double vy, double g, double level, int direction,
+                    double minT, double maxT)
+{
+    // g/2 t^2 + vy t + (y0 - level) = 0
+    double a = 0.5 * g;
+    double b = vy;
+    double c = y0 - level;
+
+    double roots[2];
+    int count = 0;
+
+    if (std::abs(a) < 1e-15) {
+        if (b == 0) return -1;
+        roots[count++] = -c / b;
+    } else {
+        double disc = b * b - 4 * a * c;
+        if (disc < 0) return -1;
+
+        // Formula estable: evita restar dos numeros casi iguales
+        double q = -0.5 * (b + std::copysign(std::sqrt(disc), b));
+        double r1 = q / a;
+        double r2 = (q != 0) ? c / q : r1;
+        roots[count++] = std::min(r1, r2);
+        roots[count++] = std::max(r1, r2);
+    }
+
+    for (int i = 0; i < count; ++i) {
+        double t = roots[i];
+        if (t <= minT || t > maxT) continue;
+
+        double vyAt = vy + g * t;
+        if (direction > 0 && vyAt <= 0) continue;
+        if (direction < 0 && vyAt >= 0) continue;
+        return t;
+    }
+    return -1;
+}
+
+// x es lineal y y tiene a lo sumo un vertice entre t0 y t1
+QRectF arcBounds(const QPointF& p0, const QPointF& v0, double g, double t0, double t1)
+{
+    QPointF a = positionAt(p0, v0, g, t0);
+    QPointF b = positionAt(p0, v0, g, t1);
+
+    double minY = std::min(a.y(), b.y());
+    double maxY = std::max(a.y(), b.y());
+
+    if (g != 0) {
+        double apex = -v0.y() / g;
+        if (apex > t0 && apex < t1) {
+            double y = positionAt(p0, v0, g, apex).y();
+            minY = std::min(minY, y);
+            maxY = std::max(maxY, y);
+        }
+    }
+
+    double minX = std::min(a.x(), b.x());
+    return QRectF(minX, minY, std::max(a.x(), b.x()) - minX, maxY - minY);
+}
+
+static double firstCornerContact(const QPointF& p0, const QPointF& v0, double g, const QPointF& corner,
+                                 double radius, double minT, double maxT)
+{
+    auto gap = [&](double t) {
+        QPointF d = positionAt(p0, v0, g, t) - corner;
+        return d.x() * d.x() + d.y() * d.y() - radius * radius;
+    };
+
+    // La rapidez es convexa en t, asi que su maximo esta en un extremo; con
+    // ese limite se muestrea de forma que entre dos muestras el centro no
+    // avance mas de un cuarto del radio
+    QPointF va = velocityAt(v0, g, minT);
+    QPointF vb = velocityAt(v0, g, maxT);
+    double speed = std::sqrt(std::max(QPointF::dotProduct(va, va), QPointF::dotProduct(vb, vb)));
+    if (speed <= 0) return -1;
+
+    double h = 0.25 * radius / speed;
+    int samples = std::min(4096, std::max(1, static_cast<int>(std::ceil((maxT - minT) / h))));
+    h = (maxT - minT) / samples;
+
+    // Solo cuenta la entrada al circulo: si empieza tocando (acaba de
+    // rebotar ahi) hay que salir primero
+    double prevT = minT;
+    bool outside = gap(minT) > 0;
+
+    for (int i = 1; i <= samples; ++i) {
+        double t = (i == samples) ? maxT : minT + i * h;
+        double value = gap(t);
+
+        if (!outside) {
+            outside = value > 0;
+        } else if (value <= 0) {
+            double lo = prevT;
+            double hi = t;
+            for (int iter = 0; iter < 60; ++iter) {
+                double mid = 0.5 * (lo + hi);
+                if (gap(mid) > 0) lo = mid; else hi = mid;
+            }
+            return hi;
+        }
+        prevT = t;
+    }
+    return -1;
+}
+
+double firstRectContact(const QPointF& p0, const QPointF& v0, double g, const QRectF& rect,
+                        double radius, double minT, double maxT, QPointF& normal)
+{
+    if (maxT <= minT) return -1;
+
+    QRectF expanded = rect.adjusted(-radius, -radius, radius, radius);
+    QRectF bounds = arcBounds(p0, v0, g, minT, maxT);
+    if (bounds.right() < expanded.left() || bounds.left() > expanded.right() ||
+        bounds.bottom() < expanded.top() || bounds.top() > expanded.bottom()) {
+        return -1;
+    }
+
+    double best = -1;
+    double t;
+
+    auto consider = [&](double candidate, const QPointF& n) {
+        if (candidate > 0 && (best < 0 || candidate < best)) {
+            best = candidate;
+            normal = n;
+        }
+    };
+
+    // Caras superior e inferior (a distancia radius del borde)
+    t = firstTimeAtY(p0.y(), v0.y(), g, rect.top() - radius, 1, minT, maxT);
+    if (t > 0) {
+        double x = p0.x() + v0.x() * t;
+        if (x >= rect.left() && x <= rect.right()) consider(t, QPointF(0, -1));
+    }
+
+    t = firstTimeAtY(p0.y(), v0.y(), g, rect.bottom() + radius, -1, minT, maxT);
+    if (t > 0) {
+        double x = p0.x() + v0.x() * t;
+        if (x >= rect.left() && x <= rect.right()) consider(t, QPointF(0, 1));
+    }
+
+    // Caras izquierda y derecha
+    if (v0.x() > 0) {
+        t = firstTimeAtX(p0.x(), v0.x(), rect.left() - radius, minT, maxT);
+        if (t > 0) {
+            double y = positionAt(p0, v0, g, t).y();
+            if (y >= rect.top() && y <= rect.bottom()) consider(t, QPointF(-1, 0));
+        }
+    } else if (v0.x() < 0) {
+        t = firstTimeAtX(p0.x(), v0.x(), rect.right() + radius, minT, maxT);
+        if (t > 0) {
+            double y = positionAt(p0, v0, g, t).y();
+            if (y >= rect.top() && y <= rect.bottom()) consider(t, QPointF(1, 0));
+        }
+    }
+
+    // Esquinas redondeadas de la suma de Minkowski
+    if (radius > 0) {
+        const QPointF corners[4] = {rect.topLeft(), QPointF(rect.right(), rect.top()),
+                                    QPointF(rect.right(), rect.bottom()), QPointF(rect.left(), rect.bottom())};
+
+        for (const QPointF& corner : corners) {
+            double limit = (best > 0) ? best : maxT;
+            if (!arcBounds(p0, v0, g, minT, limit).adjusted(-radius, -radius, radius, radius).contains(corner)) {
+                continue;
+            }
+
+            t = firstCornerContact(p0, v0, g, corner, radius, minT, limit);
+            if (t > 0) {
+                consider(t, (positionAt(p0, v0, g, t) - corner) / radius);
+            }
+        }
+    }
+
+    return best;
+}
+
+} // namespace ballistics
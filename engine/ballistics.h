@@ -0,0 +1,48 @@
+#ifndef BALLISTICS_H
+#define BALLISTICS_H
+
+#include <QPointF>
+#include <QRectF>
+
+// Trayectoria exacta de un proyectil con gravedad constante g (eje y hacia
+// abajo): p(t) = p0 + v0*t + (0, g*t^2/2). Las funciones de busqueda
+// devuelven el primer instante t en (minT, maxT] o -1 si no hay evento.
+namespace ballistics {
+
+inline QPointF positionAt(const QPointF& p0, const QPointF& v0, double g, double t)
+{
+    return QPointF(p0.x() + v0.x() * t, p0.y() + v0.y() * t + 0.5 * g * t * t);
+}
+
+inline QPointF velocityAt(const QPointF& v0, double g, double t)
+{
+    return QPointF(v0.x(), v0.y() + g * t);
+}
+
+// Angulos de lanzamiento (grados sobre la horizontal, de menor a mayor)
+// con los que un disparo a velocidad speed pasa por un punto dx adelante
+// y rise mas arriba del origen (y hacia abajo, asi que rise = y0 - y).
+// Devuelve cuantos hay: 0 si no alcanza, 1 si el tiro rasante y el
+// bombeado coinciden, o 2.
+int launchAngles(double dx, double rise, double speed, double g, double angles[2]);
+
+// Caja que contiene la trayectoria entre t0 y t1
+QRectF arcBounds(const QPointF& p0, const QPointF& v0, double g, double t0, double t1);
+
+// Primer instante en que x(t) = level
+double firstTimeAtX(double x0, double vx, double level, double minT, double maxT);
+
+// Primer instante en que y(t) = level; direction = +1 solo bajando
+// (vy > 0), -1 solo subiendo, 0 en cualquier sentido
+double firstTimeAtY(double y0, double vy, double g, double level, int direction,
+                    double minT, double maxT);
+
+// Primer contacto de un circulo de radio radius con el rectangulo (radius 0
+// para un punto que entra en el rectangulo). Las caras se resuelven de forma
+// exacta y las esquinas redondeadas con biseccion. normal apunta hacia fuera.
+double firstRectContact(const QPointF& p0, const QPointF& v0, double g, const QRectF& rect,
+                        double radius, double minT, double maxT, QPointF& normal);
+
+} // namespace ballistics
+
+#endif // BALLISTICS_H
@@ -0,0 +1,23 @@
+# Incluir desde los proyectos que enlazan con el motor:
+#   include(../engine/engine.pri)
+
+# Sondas de tiempo (profiler.h): en debug siempre; en release solo con
+# "qmake CONFIG+=profiling"
+CONFIG(debug, debug|release)|profiling: DEFINES += ENGINE_PROFILING
+
+# Fisica en punto fijo (scalar.h): los proyectos que enlazan con el motor
+# necesitan la misma opcion que el motor
+engine_fixed: DEFINES += ENGINE_FIXED_POINT
+
+INCLUDEPATH += $$PWD
+DEPENDPATH += $$PWD
+
+win32:CONFIG(release, debug|release): ENGINE_LIB_DIR = $$OUT_PWD/../engine/release
+else:win32:CONFIG(debug, debug|release): ENGINE_LIB_DIR = $$OUT_PWD/../engine/debug
+else: ENGINE_LIB_DIR = $$OUT_PWD/../engine
+
+LIBS += -L$$ENGINE_LIB_DIR -lengine
+
+win32-g++: PRE_TARGETDEPS += $$ENGINE_LIB_DIR/libengine.a
+else:win32:!win32-g++: PRE_TARGETDEPS += $$ENGINE_LIB_DIR/engine.lib
+else: PRE_TARGETDEPS += $$ENGINE_LIB_DIR/libengine.a
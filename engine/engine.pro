@@ -0,0 +1,77 @@
+TEMPLATE = lib
+TARGET = engine
+
+QT = core
+
+CONFIG += staticlib c++17
+
+# Sondas de tiempo (profiler.h): en debug siempre; en release solo con
+# "qmake CONFIG+=profiling"
+CONFIG(debug, debug|release)|profiling: DEFINES += ENGINE_PROFILING
+
+# "qmake CONFIG+=engine_avx2" activa el kernel AVX2 de ProjectileBatch
+# (sin esta opcion se usa SSE2 en x86-64)
+engine_avx2 {
+    msvc: QMAKE_CXXFLAGS += /arch:AVX2
+    else: QMAKE_CXXFLAGS += -mavx2
+}
+
+# "qmake CONFIG+=engine_fixed" compila la fisica en punto fijo (scalar.h)
+# para que las trayectorias sean iguales bit a bit en cualquier compilacion
+engine_fixed {
+    DEFINES += ENGINE_FIXED_POINT
+    SOURCES += fixedpoint.cpp
+    HEADERS += fixedpoint.h
+}
+
+# You can make your code fail to compile if it uses deprecated APIs.
+# In order to do so, uncomment the following line.
+#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+SOURCES += \
+    autoaim.cpp \
+    ballistics.cpp \
+    gameengine.cpp \
+    hitmap.cpp \
+    infrastructure.cpp \
+    level.cpp \
+    profiler.cpp \
+    projectile.cpp \
+    projectilebatch.cpp \
+    replay.cpp \
+    shotplanner.cpp \
+    shotrunner.cpp \
+    shotsweep.cpp \
+    simulationclock.cpp \
+    simulationthread.cpp \
+    spatialgrid.cpp \
+    statehistory.cpp \
+    telemetry.cpp \
+    trajectorycache.cpp \
+    workstealing.cpp
+
+HEADERS += \
+    autoaim.h \
+    ballistics.h \
+    gameengine.h \
+    gameevents.h \
+    hitmap.h \
+    infrastructure.h \
+    integrator.h \
+    level.h \
+    profiler.h \
+    projectile.h \
+    projectilebatch.h \
+    replay.h \
+    scalar.h \
+    shotplanner.h \
+    shotrunner.h \
+    shotsweep.h \
+    simulationclock.h \
+    simulationthread.h \
+    spatialgrid.h \
+    spscbuffer.h \
+    statehistory.h \
+    telemetry.h \
+    trajectorycache.h \
+    workstealing.h
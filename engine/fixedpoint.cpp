@@ -0,0 +1,102 @@
+#include "fixedpoint.h"
+#include <array>
+#include <cmath>
+
+namespace {
+
+constexpr int trigTableSize = 4096;  // Intervalos en un cuarto de vuelta
+
+// Seno de i/trigTableSize de cuarto de vuelta por la serie de Taylor en
+// Q2.61 con productos de 128 bits: todo entero, asi que la tabla sale igual
+// con cualquier compilador
+constexpr qint64 quarterSine(int i)
+{
+    constexpr int bits = 61;
+    constexpr qint64 halfPi = 3622009729038561421LL;  // pi/2 en Q2.61
+
+    const qint64 x = qint64(__int128(halfPi) * i / trigTableSize);
+    const qint64 x2 = qint64((__int128(x) * x) >> bits);
+
+    qint64 term = x;
+    qint64 sum = x;
+    for (int k = 1; k <= 12; ++k) {
+        term = -qint64(((__int128(term) * x2) >> bits) / ((2 * k) * (2 * k + 1)));
+        sum += term;
+    }
+
+    // De Q2.61 a Q32.32 redondeando
+    return (sum + (qint64(1) << (bits - Fixed::fractionBits - 1))) >> (bits - Fixed::fractionBits);
+}
+
+constexpr std::array<qint64, trigTableSize + 1> makeSineTable()
+{
+    std::array<qint64, trigTableSize + 1> table = {};
+    for (int i = 0; i <= trigTableSize; ++i) {
+        table[i] = quarterSine(i);
+    }
+    return table;
+}
+
+constexpr std::array<qint64, trigTableSize + 1> sineTable = makeSineTable();
+
+static_assert(sineTable[0] == 0, "sin(0) = 0");
+static_assert(sineTable[trigTableSize] == Fixed::one, "sin(90) = 1");
+
+} // namespace
+
+Fixed fixedAbs(Fixed value)
+{
+    return (value < 0) ? -value : value;
+}
+
+Fixed fixedSqrt(Fixed value)
+{
+    if (value <= 0) return Fixed();
+
+    // sqrt(raw / 2^32) * 2^32 = sqrt(raw * 2^32): raiz entera de 96 bits. La
+    // raiz en double solo da el punto de partida; la correccion entera deja
+    // exactamente el piso de la raiz, asi que el resultado no depende de ella.
+    const unsigned __int128 n = static_cast<unsigned __int128>(value.getRaw()) << Fixed::fractionBits;
+    unsigned __int128 root = static_cast<quint64>(std::sqrt(static_cast<double>(value.getRaw())) * 65536.0);
+
+    while (root * root > n) {
+        root--;
+    }
+    while ((root + 1) * (root + 1) <= n) {
+        root++;
+    }
+    return Fixed::fromRaw(static_cast<qint64>(root));
+}
+
+Fixed fixedSinDegrees(Fixed degrees)
+{
+    constexpr qint64 quarter = 90 * Fixed::one;
+    constexpr qint64 turn = 4 * quarter;
+
+    // Reducir a [0, 360) y luego al cuarto de vuelta
+    qint64 angle = degrees.getRaw() % turn;
+    if (angle < 0) angle += turn;
+
+    const int quadrant = static_cast<int>(angle / quarter);
+    qint64 offset = angle % quarter;
+    if (quadrant == 1 || quadrant == 3) {
+        offset = quarter - offset;
+    }
+
+    // Posicion en la tabla: indice entero y fraccion sobre quarter
+    const __int128 scaled = __int128(offset) * trigTableSize;
+    const int index = static_cast<int>(scaled / quarter);
+    const qint64 fraction = static_cast<qint64>(scaled % quarter);
+
+    qint64 value = sineTable[index];
+    if (index < trigTableSize) {
+        value += static_cast<qint64>(__int128(sineTable[index + 1] - sineTable[index]) * fraction / quarter);
+    }
+
+    return Fixed::fromRaw(quadrant >= 2 ? -value : value);
+}
+
+Fixed fixedCosDegrees(Fixed degrees)
+{
+    return fixedSinDegrees(degrees + 90);
+}
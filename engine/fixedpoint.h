@@ -0,0 +1,186 @@
+#ifndef FIXEDPOINT_H
+#define FIXEDPOINT_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QtGlobal>
+#include <limits>
+#include <type_traits>
+
+// Numero de punto fijo Q32.32 (32 bits enteros con signo y 32 de fraccion
+// en un entero de 64 bits) para el modo determinista del motor (scalar.h).
+// Todas las operaciones son aritmetica entera, asi que dan el mismo
+// resultado bit a bit con cualquier compilador, plataforma u optimizacion.
+// La multiplicacion y la division usan enteros de 128 bits y se saturan en
+// vez de desbordar; dividir por cero da el extremo con el signo del
+// dividendo.
+//
+// Rango: +-2147483648 con pasos de 2^-32 (unos 2.3e-10).
+#if !defined(__SIZEOF_INT128__)
+#error "El modo de punto fijo necesita enteros de 128 bits (GCC o Clang)"
+#endif
+
+class Fixed
+{
+public:
+    static constexpr int fractionBits = 32;
+    static constexpr qint64 one = qint64(1) << fractionBits;
+
+    constexpr Fixed() : raw(0) {}
+    constexpr Fixed(int value) : raw(qint64(value) * one) {}
+
+    // Redondea al valor representable mas cercano (satura fuera del rango;
+    // NaN da 0). Es explicita para que ninguna cuenta pase a double sin querer.
+    explicit constexpr Fixed(double value) : raw(rawFromDouble(value)) {}
+
+    static constexpr Fixed fromRaw(qint64 value)
+    {
+        Fixed result;
+        result.raw = value;
+        return result;
+    }
+
+    static constexpr Fixed max() { return fromRaw(std::numeric_limits<qint64>::max()); }
+    static constexpr Fixed min() { return fromRaw(std::numeric_limits<qint64>::min()); }
+
+    constexpr qint64 getRaw() const { return raw; }
+    constexpr double toDouble() const { return double(raw) / double(one); }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b)
+    {
+        qint64 sum = 0;
+        return __builtin_add_overflow(a.raw, b.raw, &sum) ? (b.raw > 0 ? max() : min()) : fromRaw(sum);
+    }
+    friend constexpr Fixed operator-(Fixed a, Fixed b)
+    {
+        qint64 difference = 0;
+        return __builtin_sub_overflow(a.raw, b.raw, &difference) ? (b.raw < 0 ? max() : min()) : fromRaw(difference);
+    }
+    friend constexpr Fixed operator-(Fixed a) { return (a.raw == min().raw) ? max() : fromRaw(-a.raw); }
+
+    // Producto redondeado al mas cercano
+    friend constexpr Fixed operator*(Fixed a, Fixed b)
+    {
+        const __int128 product = __int128(a.raw) * b.raw;
+        return fromRaw(saturate((product + (__int128(1) << (fractionBits - 1))) >> fractionBits));
+    }
+
+    // Cociente truncado hacia cero
+    friend constexpr Fixed operator/(Fixed a, Fixed b)
+    {
+        if (b.raw == 0) {
+            return (a.raw > 0) ? max() : (a.raw < 0) ? min() : Fixed();
+        }
+        return fromRaw(saturate(__int128(a.raw) * one / b.raw));
+    }
+
+    constexpr Fixed& operator+=(Fixed other) { return *this = *this + other; }
+    constexpr Fixed& operator-=(Fixed other) { return *this = *this - other; }
+    constexpr Fixed& operator*=(Fixed other) { return *this = *this * other; }
+    constexpr Fixed& operator/=(Fixed other) { return *this = *this / other; }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a.raw == b.raw; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a.raw != b.raw; }
+    friend constexpr bool operator<(Fixed a, Fixed b) { return a.raw < b.raw; }
+    friend constexpr bool operator>(Fixed a, Fixed b) { return a.raw > b.raw; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a.raw <= b.raw; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a.raw >= b.raw; }
+
+private:
+    qint64 raw;
+
+    static constexpr qint64 saturate(__int128 value)
+    {
+        return value > std::numeric_limits<qint64>::max() ? std::numeric_limits<qint64>::max()
+             : value < std::numeric_limits<qint64>::min() ? std::numeric_limits<qint64>::min()
+             : qint64(value);
+    }
+
+    static constexpr qint64 rawFromDouble(double value)
+    {
+        // Multiplicar por 2^32 es exacto; solo se redondea al pasar a entero
+        const double scaled = value * double(one);
+        return (value != value) ? 0
+             : (scaled >= 9.2233720368547758e18) ? std::numeric_limits<qint64>::max()
+             : (scaled <= -9.2233720368547758e18) ? std::numeric_limits<qint64>::min()
+             : (scaled >= 0) ? qint64(scaled + 0.5) : -qint64(-scaled + 0.5);
+    }
+};
+
+static_assert(std::is_trivially_copyable<Fixed>::value, "Fixed se copia con memcpy");
+
+Fixed fixedAbs(Fixed value);
+
+// Raiz cuadrada entera: el mayor valor representable cuyo cuadrado no pasa
+// de value (0 para negativos)
+Fixed fixedSqrt(Fixed value);
+
+// Seno y coseno de un angulo en grados, interpolando linealmente una tabla
+// de un cuarto de vuelta calculada en compilacion con aritmetica entera
+// (error menor a 2e-8)
+Fixed fixedSinDegrees(Fixed degrees);
+Fixed fixedCosDegrees(Fixed degrees);
+
+// Punto y rectangulo de punto fijo con la parte de la interfaz de QPointF y
+// QRectF que usa el motor, para que el mismo codigo compile con los dos tipos
+class FixedVector
+{
+public:
+    constexpr FixedVector() {}
+    constexpr FixedVector(Fixed x, Fixed y) : xp(x), yp(y) {}
+
+    constexpr Fixed x() const { return xp; }
+    constexpr Fixed y() const { return yp; }
+    void setX(Fixed x) { xp = x; }
+    void setY(Fixed y) { yp = y; }
+
+    friend constexpr FixedVector operator+(const FixedVector& a, const FixedVector& b) { return FixedVector(a.xp + b.xp, a.yp + b.yp); }
+    friend constexpr FixedVector operator-(const FixedVector& a, const FixedVector& b) { return FixedVector(a.xp - b.xp, a.yp - b.yp); }
+    friend constexpr FixedVector operator-(const FixedVector& a) { return FixedVector(-a.xp, -a.yp); }
+    friend constexpr FixedVector operator*(const FixedVector& a, Fixed factor) { return FixedVector(a.xp * factor, a.yp * factor); }
+    friend constexpr FixedVector operator/(const FixedVector& a, Fixed divisor) { return FixedVector(a.xp / divisor, a.yp / divisor); }
+    FixedVector& operator+=(const FixedVector& other) { return *this = *this + other; }
+    FixedVector& operator-=(const FixedVector& other) { return *this = *this - other; }
+
+    friend constexpr bool operator==(const FixedVector& a, const FixedVector& b) { return a.xp == b.xp && a.yp == b.yp; }
+    friend constexpr bool operator!=(const FixedVector& a, const FixedVector& b) { return !(a == b); }
+
+private:
+    Fixed xp;
+    Fixed yp;
+};
+
+class FixedRect
+{
+public:
+    constexpr FixedRect() {}
+    constexpr FixedRect(Fixed x, Fixed y, Fixed width, Fixed height) : xp(x), yp(y), w(width), h(height) {}
+
+    constexpr Fixed x() const { return xp; }
+    constexpr Fixed y() const { return yp; }
+    constexpr Fixed width() const { return w; }
+    constexpr Fixed height() const { return h; }
+    constexpr Fixed left() const { return xp; }
+    constexpr Fixed top() const { return yp; }
+    constexpr Fixed right() const { return xp + w; }
+    constexpr Fixed bottom() const { return yp + h; }
+    constexpr FixedVector topLeft() const { return FixedVector(xp, yp); }
+
+    // Bordes incluidos, como QRectF::contains
+    constexpr bool contains(const FixedVector& p) const
+    {
+        return p.x() >= left() && p.x() <= right() && p.y() >= top() && p.y() <= bottom();
+    }
+
+private:
+    Fixed xp, yp, w, h;
+};
+
+inline double toDouble(Fixed value) { return value.toDouble(); }
+inline QPointF toQPointF(const FixedVector& v) { return QPointF(v.x().toDouble(), v.y().toDouble()); }
+inline QRectF toQRectF(const FixedRect& r)
+{
+    return QRectF(r.x().toDouble(), r.y().toDouble(), r.width().toDouble(), r.height().toDouble());
+}
+
+#endif // FIXEDPOINT_H
@@ -0,0 +1,874 @@
+#include "gameengine.h"
+#include "ballistics.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <QDebug>
+
+// Cara del bloque (como getCollisionSide: 0 arriba, 1 derecha, 2 abajo,
+// 3 izquierda) a partir de la normal de contacto; en las esquinas gana el
+// eje dominante
+static int sideFromNormal(const Vec2& normal)
+{
+    if (scalarAbs(normal.y()) >= scalarAbs(normal.x())) {
+        return (normal.y() < 0) ? 0 : 2;
+    }
+    return (normal.x() > 0) ? 1 : 3;
+}
+
+// Fuente de las versiones del escenario, compartida por todos los motores
+static std::atomic<quint64> layoutVersionCounter(0);
+
+GameEngine::GameEngine(double w, double h)
+    : boxWidth(toScalar(w)), boxHeight(toScalar(h)), floorY(toScalar(550.0)), currentPlayer(1),
+    gameOver(false), winner(0), player1Alive(0), player2Alive(0), gridsDirty(false),
+    eventCallback(nullptr), eventContext(nullptr), projectileCount(0), eventSlot(-1),
+    continuousCollision(false), eventDriven(false), integrator(Integrator::Euler),
+    adaptiveStep(false), fineStepDistance(4.0), layoutVersion(0)
+{
+    touchLayout();
+
+    // Cañones a la altura 175 en las esquinas y el rival de cada jugador
+    // en el centro de su lado, sobre el suelo
+    cannonPositions[0] = QPointF(35, 175);
+    cannonPositions[1] = QPointF(w - 35, 175);
+    rivalZones[0] = toRect(QRectF(240, 440, 60, 110));
+    rivalZones[1] = toRect(QRectF(690, 440, 60, 110));
+}
+
+GameEngine::GameEngine(const GameEngine& other)
+    : boxWidth(other.boxWidth), boxHeight(other.boxHeight), floorY(other.floorY),
+    currentPlayer(other.currentPlayer), gameOver(other.gameOver), winner(other.winner),
+    player1Infrastructure(other.player1Infrastructure),
+    player2Infrastructure(other.player2Infrastructure),
+    player1Grid(other.player1Grid), player2Grid(other.player2Grid),
+    player1Alive(other.player1Alive), player2Alive(other.player2Alive),
+    gridsDirty(other.gridsDirty),
+    eventCallback(nullptr), eventContext(nullptr),
+    projectileCount(other.projectileCount), eventSlot(other.eventSlot),
+    shotStats(other.shotStats), continuousCollision(other.continuousCollision),
+    eventDriven(other.eventDriven), integrator(other.integrator),
+    adaptiveStep(other.adaptiveStep), fineStepDistance(other.fineStepDistance),
+    layoutVersion(other.layoutVersion)
+{
+    std::copy(other.projectiles, other.projectiles + projectileCount, projectiles);
+    std::copy(other.cannonPositions, other.cannonPositions + 2, cannonPositions);
+    std::copy(other.rivalZones, other.rivalZones + 2, rivalZones);
+}
+
+GameEngine& GameEngine::operator=(const GameEngine& other)
+{
+    if (this == &other) return *this;
+
+    boxWidth = other.boxWidth;
+    boxHeight = other.boxHeight;
+    floorY = other.floorY;
+    std::copy(other.cannonPositions, other.cannonPositions + 2, cannonPositions);
+    std::copy(other.rivalZones, other.rivalZones + 2, rivalZones);
+    currentPlayer = other.currentPlayer;
+    gameOver = other.gameOver;
+    winner = other.winner;
+    shotStats = other.shotStats;
+    continuousCollision = other.continuousCollision;
+    eventDriven = other.eventDriven;
+    integrator = other.integrator;
+    adaptiveStep = other.adaptiveStep;
+    fineStepDistance = other.fineStepDistance;
+    layoutVersion = other.layoutVersion;
+
+    // Con el mismo escenario se copian los bloques uno a uno para reutilizar
+    // la memoria propia en vez de volver a compartirla (y reservarla de nuevo
+    // en el siguiente golpe). Asi reiniciar una copia de trabajo no reserva memoria.
+    if (player1Infrastructure.size() == other.player1Infrastructure.size() &&
+        player2Infrastructure.size() == other.player2Infrastructure.size()) {
+        for (int i = 0; i < player1Infrastructure.size(); ++i) {
+            player1Infrastructure[i] = other.player1Infrastructure[i];
+        }
+        for (int i = 0; i < player2Infrastructure.size(); ++i) {
+            player2Infrastructure[i] = other.player2Infrastructure[i];
+        }
+    } else {
+        player1Infrastructure = other.player1Infrastructure;
+        player2Infrastructure = other.player2Infrastructure;
+    }
+
+    // Las rejillas son arreglos planos: con el mismo escenario se copian
+    // sobre la memoria que ya tienen
+    player1Grid = other.player1Grid;
+    player2Grid = other.player2Grid;
+    player1Alive = other.player1Alive;
+    player2Alive = other.player2Alive;
+    gridsDirty = other.gridsDirty;
+
+    projectileCount = other.projectileCount;
+    std::copy(other.projectiles, other.projectiles + projectileCount, projectiles);
+    eventSlot = other.eventSlot;
+
+    return *this;
+}
+
+void GameEngine::snapshot(GameState& state, std::vector<double>& resistance) const
+{
+    state.player1Blocks = player1Infrastructure.size();
+    state.player2Blocks = player2Infrastructure.size();
+    resistance.resize(state.player1Blocks + state.player2Blocks);
+    for (int i = 0; i < state.player1Blocks; ++i) {
+        resistance[i] = player1Infrastructure[i].getResistance();
+    }
+    for (int i = 0; i < state.player2Blocks; ++i) {
+        resistance[state.player1Blocks + i] = player2Infrastructure[i].getResistance();
+    }
+
+    state.projectileCount = projectileCount;
+    std::copy(projectiles, projectiles + projectileCount, state.projectiles);
+    state.shotStats = shotStats;
+    state.currentPlayer = currentPlayer;
+    state.gameOver = gameOver;
+    state.winner = winner;
+}
+
+bool GameEngine::restore(const GameState& state, const double* resistance)
+{
+    if (state.player1Blocks != player1Infrastructure.size() ||
+        state.player2Blocks != player2Infrastructure.size()) {
+        return false;
+    }
+
+    // Los bloques que se destruyen salen de la rejilla uno a uno y los que
+    // vuelven a estar en pie vuelven a entrar; solo si alguno no estaba en
+    // la rejilla al construirla se reconstruye en la siguiente consulta
+    // (sobre la memoria que ya tiene)
+    bool changed = false;
+    auto restoreBlocks = [this, &changed](QVector<Infrastructure>& blocks, SpatialGrid& grid,
+                                          const double* resistance, int& alive) {
+        alive = 0;
+        for (int i = 0; i < blocks.size(); ++i) {
+            Infrastructure& block = blocks[i];
+            bool wasDestroyed = block.isDestroyed();
+            if (block.getResistance() != resistance[i]) changed = true;
+            block.setResistance(resistance[i]);
+
+            if (!block.isDestroyed()) {
+                alive++;
+                if (wasDestroyed && !gridsDirty && !grid.restore(i, block.getRect())) gridsDirty = true;
+            } else if (!wasDestroyed && !gridsDirty) {
+                grid.remove(i, block.getRect());
+            }
+        }
+    };
+
+    restoreBlocks(player1Infrastructure, player1Grid, resistance, player1Alive);
+    restoreBlocks(player2Infrastructure, player2Grid, resistance + state.player1Blocks, player2Alive);
+    if (changed) touchLayout();
+
+    restoreMatch(state.projectiles, state.projectileCount, state.shotStats,
+                 state.currentPlayer, state.gameOver, state.winner);
+    return true;
+}
+
+void GameEngine::setBlockResistance(int player, int index, double resistance)
+{
+    QVector<Infrastructure>& blocks = (player == 1) ? player1Infrastructure : player2Infrastructure;
+    Infrastructure& block = blocks[index];
+    if (block.getResistance() == resistance) return;
+
+    // Igual que en restore(): un bloque que vuelve a estar en pie vuelve a
+    // la rejilla o, si no tiene lugar, obliga a reconstruirla
+    bool wasDestroyed = block.isDestroyed();
+    block.setResistance(resistance);
+    touchLayout();
+
+    int& alive = (player == 1) ? player1Alive : player2Alive;
+    if (!block.isDestroyed()) {
+        if (wasDestroyed) {
+            alive++;
+            SpatialGrid& grid = (player == 1) ? player1Grid : player2Grid;
+            if (!gridsDirty && !grid.restore(index, block.getRect())) gridsDirty = true;
+        }
+    } else if (!wasDestroyed) {
+        alive--;
+        if (!gridsDirty) ((player == 1) ? player1Grid : player2Grid).remove(index, block.getRect());
+    }
+}
+
+void GameEngine::restoreMatch(const Projectile* shot, int count, const ShotStats& stats,
+                              int player, bool over, int winningPlayer)
+{
+    projectileCount = std::max(0, std::min(count, int(maxProjectiles)));
+    std::copy(shot, shot + projectileCount, projectiles);
+    shotStats = stats;
+    currentPlayer = player;
+    gameOver = over;
+    winner = winningPlayer;
+}
+
+void GameEngine::addInfrastructure(int player, const Infrastructure& infra)
+{
+    touchLayout();
+    if (player == 1) {
+        player1Infrastructure.append(infra);
+        if (!infra.isDestroyed()) player1Alive++;
+    } else {
+        player2Infrastructure.append(infra);
+        if (!infra.isDestroyed()) player2Alive++;
+    }
+
+    // La rejilla se reconstruye una sola vez en la siguiente consulta
+    gridsDirty = true;
+}
+
+void GameEngine::reserveInfrastructure(int player, int count)
+{
+    // Para niveles grandes: evita crecer el vector bloque a bloque
+    QVector<Infrastructure>& blocks = (player == 1) ? player1Infrastructure : player2Infrastructure;
+    blocks.reserve(count);
+}
+
+void GameEngine::buildSpatialIndex()
+{
+    // Un poco mas que la caja para que los bloques del borde no se
+    // amontonen en la ultima celda
+    QRectF bounds(-100, -100, getBoxWidth() + 200, getBoxHeight() + 200);
+    player1Grid.build(bounds, player1Infrastructure);
+    player2Grid.build(bounds, player2Infrastructure);
+    gridsDirty = false;
+}
+
+void GameEngine::queryTargets(const QRectF& area)
+{
+    if (gridsDirty) {
+        buildSpatialIndex();
+    }
+
+    const SpatialGrid& grid = (currentPlayer == 1) ? player2Grid : player1Grid;
+    grid.query(area, candidates);
+}
+
+void GameEngine::loadDefaultLayout()
+{
+    // Infraestructura Jugador 1 (izquierda) - como en la imagen
+    addInfrastructure(1, Infrastructure(170, 280, 55, 270, 200));  // Izquierda
+    addInfrastructure(1, Infrastructure(170, 230, 200, 50, 100));  // Arriba (centro)
+    addInfrastructure(1, Infrastructure(315, 280, 55, 270, 200));  // Derecha
+
+    // Infraestructura Jugador 2 (derecha) - como en la imagen
+    addInfrastructure(2, Infrastructure(620, 280, 55, 270, 200));  // Izquierda
+    addInfrastructure(2, Infrastructure(620, 230, 200, 50, 100));  // Arriba (centro)
+    addInfrastructure(2, Infrastructure(765, 280, 55, 270, 200));  // Derecha
+}
+
+void GameEngine::launchProjectile(int player, double angle, double speed)
+{
+    launchVolley(player, angle, speed, 1, 0.0);
+}
+
+void GameEngine::launchVolley(int player, double angle, double speed, int count, double spread)
+{
+    // Lanzar desde la posición del cañón (reemplaza a los proyectiles
+    // anteriores; los lugares del arreglo se reutilizan)
+    QPointF start = getCannonPosition(player);
+    count = std::max(1, std::min(count, int(maxProjectiles)));
+
+    shotStats = ShotStats();
+    projectileCount = count;
+
+    for (int i = 0; i < count; ++i) {
+        // Angulos repartidos de forma pareja en [angle - spread/2, angle + spread/2]
+        double shotAngle = (count == 1) ? angle : angle - spread / 2 + spread * i / (count - 1);
+
+        // Pasar el jugador al constructor para que ajuste la dirección
+        projectiles[i] = Projectile(start.x(), start.y(), shotAngle, speed, projectileMass, player);
+
+        eventSlot = i;
+        publishEvent(GameEventType::Launch, player);
+    }
+    eventSlot = -1;
+}
+
+bool GameEngine::hasActiveProjectiles() const
+{
+    for (int i = 0; i < projectileCount; ++i) {
+        if (projectiles[i].isActive()) return true;
+    }
+    return false;
+}
+
+bool GameEngine::update(double dt)
+{
+    if (!hasActiveProjectiles()) {
+        return false;
+    }
+
+    shotStats.steps++;
+
+    // Cada proyectil de la andanada avanza por separado sobre los mismos
+    // bloques, en el orden del arreglo
+    bool anyActive = false;
+    for (int i = 0; i < projectileCount; ++i) {
+        Projectile& projectile = projectiles[i];
+        if (!projectile.isActive()) continue;
+
+        eventSlot = i;
+        if (eventDriven) {
+            // Resolver todos los eventos que caen dentro de dt (con un tope por
+            // si el proyectil queda atrapado rebotando en una esquina)
+            double remaining = dt;
+            for (int events = 0; events < 16 && remaining > 0 && projectile.isActive(); ++events) {
+                remaining -= advanceAnalytic(projectile, remaining);
+            }
+        } else if (adaptiveStep) {
+            advanceAdaptive(projectile, dt);
+        } else {
+            updateProjectile(projectile, dt);
+        }
+
+        anyActive = anyActive || projectile.isActive();
+    }
+    eventSlot = -1;
+
+    return anyActive;
+}
+
+bool GameEngine::updateProjectile(Projectile& projectile, double dt)
+{
+    Vec2 from = projectile.getScalarPosition();
+
+    // Actualizar proyectil
+    projectile.update(dt, integrator);
+
+    // Obtener posición DESPUÉS de actualizar
+    Vec2 pos = projectile.getScalarPosition();
+
+    // Verificar límites básicos PRIMERO para evitar valores inválidos
+    if (pos.x() < -100 || pos.x() > boxWidth + 100 ||
+        pos.y() < -100 || pos.y() > boxHeight + 100) {
+        projectile.setActive(false);
+        return false;
+    }
+
+    // Verificar si el proyectil toca al rival ANTES de manejar colisiones
+    const Rect& rivalZone1 = rivalZones[0];
+    const Rect& rivalZone2 = rivalZones[1];
+
+    // Con colision continua tambien cuenta atravesar la zona durante el paso
+    Scalar toi;
+    Vec2 normal;
+    bool crossesRival1 = rivalZone1.contains(pos) ||
+        (continuousCollision && Infrastructure::sweepCircleRect(rivalZone1, from, pos, 0, toi, normal));
+    bool crossesRival2 = rivalZone2.contains(pos) ||
+        (continuousCollision && Infrastructure::sweepCircleRect(rivalZone2, from, pos, 0, toi, normal));
+
+    // Si el jugador actual es 1, verificar si golpea al rival 2
+    if (currentPlayer == 1 && crossesRival2) {
+        publishEvent(GameEventType::RivalHit, 1);
+        endGame(1);
+        projectile.setActive(false);
+        return false;
+    }
+
+    // Si el jugador actual es 2, verificar si golpea al rival 1
+    if (currentPlayer == 2 && crossesRival1) {
+        publishEvent(GameEventType::RivalHit, 2);
+        endGame(2);
+        projectile.setActive(false);
+        return false;
+    }
+
+    // Manejar colisiones DESPUÉS de verificar victoria
+    handleWallCollisions(projectile);
+
+    // Verificar si sigue activo después de colisión con pared
+    if (!projectile.isActive()) {
+        return false;
+    }
+
+    if (continuousCollision) {
+        handleSweptInfrastructureCollisions(projectile, from);
+    } else {
+        handleInfrastructureCollisions(projectile);
+    }
+
+    // Verificar si fue desactivado por rebotes
+    if (!projectile.isActive()) {
+        return false;
+    }
+
+    // Verificar si el proyectil salió del área de juego normal
+    if (pos.y() > boxHeight + 50) {
+        projectile.setActive(false);
+        return false;
+    }
+
+    return true;
+}
+
+void GameEngine::advanceAdaptive(Projectile& projectile, double dt)
+{
+    double remaining = dt;
+    for (int step = 0; step < maxSubSteps && projectile.isActive(); ++step) {
+        // El ultimo subpaso permitido se lleva lo que falte
+        double h = (step == maxSubSteps - 1) ? remaining : adaptiveStepLength(projectile, remaining);
+        updateProjectile(projectile, h);
+
+        remaining -= h;
+        if (remaining <= dt * 1e-9) break;  // Restos de redondeo de remaining / n
+    }
+}
+
+double GameEngine::adaptiveStepLength(const Projectile& projectile, double remaining)
+{
+    // Caja que contiene todo el recorrido posible en remaining: en x avanza
+    // |vx| t y en y |vy| t + g t^2 / 2, mas el radio y otro radio de margen.
+    // Se calcula en el tipo de la fisica para que en punto fijo la eleccion
+    // del paso tampoco dependa del compilador.
+    const Vec2& pos = projectile.getScalarPosition();
+    const Vec2& vel = projectile.getScalarVelocity();
+    const Scalar t = toScalar(remaining);
+    const Scalar margin = projectile.getScalarRadius() * 2;
+    const Scalar travelX = scalarAbs(vel.x()) * t;
+    const Scalar travelY = scalarAbs(vel.y()) * t + Scalar(Projectile::getGravity()) * t * t / 2;
+    const Rect reach(pos.x() - travelX - margin, pos.y() - travelY - margin,
+                     (travelX + margin) * 2, (travelY + margin) * 2);
+
+    // Paredes, techo y piso (mismos limites que handleWallCollisions)
+    bool open = reach.left() > 0 && reach.right() < boxWidth &&
+                reach.top() > 0 && reach.bottom() < floorY;
+
+    // Zona del rival y bloques en pie del jugador contrario
+    const Rect& rivalZone = rivalZones[currentPlayer == 1 ? 1 : 0];
+    auto overlaps = [&reach](const Rect& r) {
+        return reach.left() < r.right() && r.left() < reach.right() &&
+               reach.top() < r.bottom() && r.top() < reach.bottom();
+    };
+    open = open && !overlaps(rivalZone);
+
+    if (open) {
+        queryTargets(toQRectF(reach));
+        const QVector<Infrastructure>& targets =
+            (currentPlayer == 1) ? player2Infrastructure : player1Infrastructure;
+        for (int i : candidates) {
+            if (overlaps(targets[i].getScalarRect())) {
+                open = false;
+                break;
+            }
+        }
+    }
+
+    if (open) return remaining;
+
+    // Cerca de algo: subpasos iguales que avanzan a lo sumo fineStepDistance
+    const double travel = toDouble(travelX + travelY);
+    const int pieces = std::min(maxSubSteps, std::max(1, int(std::ceil(travel / fineStepDistance))));
+    return remaining / pieces;
+}
+
+bool GameEngine::advanceToNextEvent()
+{
+    if (!hasActiveProjectiles()) {
+        return false;
+    }
+
+    // Con una andanada cada proyectil salta a su propio siguiente evento
+    shotStats.steps++;
+    bool anyActive = false;
+    for (int i = 0; i < projectileCount; ++i) {
+        if (!projectiles[i].isActive()) continue;
+
+        eventSlot = i;
+        advanceAnalytic(projectiles[i], std::numeric_limits<double>::infinity());
+        anyActive = anyActive || projectiles[i].isActive();
+    }
+    eventSlot = -1;
+    return anyActive;
+}
+
+double GameEngine::advanceAnalytic(Projectile& projectile, double maxTime)
+{
+    // Margen para no volver a detectar el evento que se acaba de resolver
+    const double minTime = 1e-9;
+
+    enum EventType { None, WallLeft, WallRight, Ceiling, Floor, Rival, Block };
+
+    QPointF p0 = projectile.getPosition();
+    QPointF v0 = projectile.getVelocity();
+    double radius = projectile.getRadius();
+    const double g = Projectile::getGravity();
+
+    EventType event = None;
+    double eventTime = maxTime;
+    int blockIndex = -1;
+    QPointF blockNormal;
+    double t;
+
+    // Paredes, techo y piso (mismos limites que handleWallCollisions)
+    if (v0.x() < 0) {
+        t = ballistics::firstTimeAtX(p0.x(), v0.x(), radius, minTime, eventTime);
+        if (t > 0) { event = WallLeft; eventTime = t; }
+    } else if (v0.x() > 0) {
+        t = ballistics::firstTimeAtX(p0.x(), v0.x(), getBoxWidth() - radius, minTime, eventTime);
+        if (t > 0) { event = WallRight; eventTime = t; }
+    }
+
+    t = ballistics::firstTimeAtY(p0.y(), v0.y(), g, radius, -1, minTime, eventTime);
+    if (t > 0) { event = Ceiling; eventTime = t; }
+
+    t = ballistics::firstTimeAtY(p0.y(), v0.y(), g, getFloorY() - radius, 1, minTime, eventTime);
+    if (t > 0) { event = Floor; eventTime = t; }
+
+    // Zona del rival: cuenta cuando entra el centro del proyectil
+    QPointF ignored;
+    t = ballistics::firstRectContact(p0, v0, g, getRivalZone(currentPlayer == 1 ? 2 : 1), 0,
+                                     minTime, eventTime, ignored);
+    if (t > 0 && t < eventTime) { event = Rival; eventTime = t; }
+
+    // Bloques enemigos que siguen en pie cerca del arco hasta el primer
+    // evento encontrado (paredes y piso acotan siempre ese tiempo)
+    QVector<Infrastructure>& targetInfra =
+        (currentPlayer == 1) ? player2Infrastructure : player1Infrastructure;
+
+    QRectF arc = std::isinf(eventTime)
+        ? QRectF(-1e9, -1e9, 2e9, 2e9)
+        : ballistics::arcBounds(p0, v0, g, 0, eventTime).adjusted(-radius, -radius, radius, radius);
+    queryTargets(arc);
+
+    for (int i : candidates) {
+        if (targetInfra[i].isDestroyed()) continue;
+
+        QPointF normal;
+        t = ballistics::firstRectContact(p0, v0, g, targetInfra[i].getRect(), radius,
+                                         minTime, eventTime, normal);
+        if (t > 0 && t < eventTime) {
+            event = Block;
+            eventTime = t;
+            blockIndex = i;
+            blockNormal = normal;
+        }
+    }
+
+    if (event == None) {
+        if (std::isinf(maxTime)) {
+            // Sin eventos posibles (no deberia ocurrir con piso y paredes)
+            projectile.setActive(false);
+            return 0;
+        }
+        projectile.setPosition(ballistics::positionAt(p0, v0, g, maxTime));
+        projectile.setVelocity(ballistics::velocityAt(v0, g, maxTime));
+        return maxTime;
+    }
+
+    QPointF pos = ballistics::positionAt(p0, v0, g, eventTime);
+    QPointF vel = ballistics::velocityAt(v0, g, eventTime);
+
+    // Estado en el instante del contacto, antes de resolverlo, para los eventos
+    projectile.setPosition(pos);
+    projectile.setVelocity(vel);
+
+    switch (event) {
+    case WallLeft:
+        publishEvent(GameEventType::WallBounce, currentPlayer, -1, 0);
+        pos.setX(radius);
+        vel.setX(-vel.x());
+        break;
+    case WallRight:
+        publishEvent(GameEventType::WallBounce, currentPlayer, -1, 1);
+        pos.setX(getBoxWidth() - radius);
+        vel.setX(-vel.x());
+        break;
+    case Ceiling:
+        publishEvent(GameEventType::WallBounce, currentPlayer, -1, 2);
+        pos.setY(radius);
+        vel.setY(-vel.y());
+        break;
+    case Floor:
+        publishEvent(GameEventType::WallBounce, currentPlayer, -1, 3);
+        pos.setY(getFloorY() - radius);
+        vel.setY(-vel.y() * 0.8);
+        break;
+    case Rival:
+        publishEvent(GameEventType::RivalHit, currentPlayer);
+        endGame(currentPlayer);
+        projectile.setActive(false);
+        return eventTime;
+    case Block: {
+        damageInfrastructure(currentPlayer == 1 ? 2 : 1, blockIndex, sideFromNormal(toVec2(blockNormal)), toVec2(vel));
+
+        // Invertir la componente normal con el coeficiente de restitucion
+        double normalSpeed = QPointF::dotProduct(vel, blockNormal);
+        if (normalSpeed < 0) {
+            vel -= blockNormal * ((1 + restitutionCoefficient) * normalSpeed);
+        }
+        break;
+    }
+    case None:
+        break;
+    }
+
+    projectile.setPosition(pos);
+    projectile.setVelocity(vel);
+    projectile.incrementBounce();
+
+    // Si ya rebotó 3 veces, desactivar el proyectil
+    if (projectile.getBounceCount() >= 3) {
+        projectile.setActive(false);
+    }
+
+    if (event == Block) {
+        checkVictoryConditions();
+    }
+
+    return eventTime;
+}
+
+void GameEngine::handleWallCollisions(Projectile& projectile)
+{
+    if (!projectile.isActive()) return;
+
+    Vec2 pos = projectile.getScalarPosition();
+    Vec2 vel = projectile.getScalarVelocity();
+    Scalar radius = projectile.getScalarRadius();
+
+    bool collided = false;
+
+    // Colisión con pared izquierda
+    if (pos.x() - radius <= 0) {
+        publishEvent(GameEventType::WallBounce, currentPlayer, -1, 0);
+        vel.setX(-vel.x());
+        pos.setX(radius);
+        collided = true;
+    }
+    // Colisión con pared derecha
+    else if (pos.x() + radius >= boxWidth) {
+        publishEvent(GameEventType::WallBounce, currentPlayer, -1, 1);
+        vel.setX(-vel.x());
+        pos.setX(boxWidth - radius);
+        collided = true;
+    }
+
+    // Colisión con techo
+    if (pos.y() - radius <= 0) {
+        publishEvent(GameEventType::WallBounce, currentPlayer, -1, 2);
+        vel.setY(-vel.y());
+        pos.setY(radius);
+        collided = true;
+    }
+
+    // Colisión con piso (elástica)
+    if (pos.y() + radius >= floorY) {
+        publishEvent(GameEventType::WallBounce, currentPlayer, -1, 3);
+        vel.setY(-vel.y() * Scalar(0.8));
+        pos.setY(floorY - radius);
+        collided = true;
+    }
+
+    if (collided) {
+        projectile.setScalarVelocity(vel);
+        projectile.setScalarPosition(pos);
+        projectile.incrementBounce();  // incremetnar  contador de rebotes
+
+        // Si ya rebotó 3 veces, desactivar el proyectil
+        if (projectile.getBounceCount() >= 3) {
+            projectile.setActive(false);
+        }
+    }
+}
+
+void GameEngine::handleInfrastructureCollisions(Projectile& projectile)
+{
+    if (!projectile.isActive()) return;
+
+    Vec2 pos = projectile.getScalarPosition();
+    Vec2 vel = projectile.getScalarVelocity();
+    Scalar radius = projectile.getScalarRadius();
+
+    int targetPlayer = (currentPlayer == 1) ? 2 : 1;
+    QVector<Infrastructure>* targetInfra =
+        (currentPlayer == 1) ? &player2Infrastructure : &player1Infrastructure;
+
+    // Solo los bloques de las celdas que toca el proyectil, en orden de indice
+    queryTargets(toQRectF(Rect(pos.x() - radius, pos.y() - radius, 2 * radius, 2 * radius)));
+
+    for (int i : candidates) {
+        if ((*targetInfra)[i].checkCollision(pos, radius) && (*targetInfra)[i].getScalarResistance() != 0) {
+            Vec2 prevPos = pos - vel * Scalar(0.01);
+            int side = (*targetInfra)[i].getCollisionSide(pos, prevPos);
+
+            damageInfrastructure(targetPlayer, i, side, vel);
+
+            if (side == 0 || side == 2) {
+                vel.setY(-vel.y() * Scalar(restitutionCoefficient));
+            } else {
+                vel.setX(-vel.x() * Scalar(restitutionCoefficient));
+            }
+
+            projectile.setScalarVelocity(vel);
+            projectile.incrementBounce();  // contar rebote con infraestructura también
+
+
+            // Si ya rebotó 3 veces, desactivar
+            if (projectile.getBounceCount() >= 3) {
+                projectile.setActive(false);
+            }
+
+            checkVictoryConditions();
+            break;
+        }
+    }
+}
+
+void GameEngine::handleSweptInfrastructureCollisions(Projectile& projectile, const Vec2& from)
+{
+    if (!projectile.isActive()) return;
+
+    Vec2 to = projectile.getScalarPosition();
+    Vec2 vel = projectile.getScalarVelocity();
+    Scalar radius = projectile.getScalarRadius();
+
+    int targetPlayer = (currentPlayer == 1) ? 2 : 1;
+    QVector<Infrastructure>* targetInfra =
+        (currentPlayer == 1) ? &player2Infrastructure : &player1Infrastructure;
+
+    // Buscar el primer bloque que toca el proyectil durante el paso entre
+    // los de las celdas que cubre el recorrido
+    int hitIndex = -1;
+    Scalar hitToi = 2;
+    Vec2 hitNormal;
+
+    Rect path(std::min(from.x(), to.x()) - radius, std::min(from.y(), to.y()) - radius,
+              scalarAbs(to.x() - from.x()) + 2 * radius, scalarAbs(to.y() - from.y()) + 2 * radius);
+    queryTargets(toQRectF(path));
+
+    for (int i : candidates) {
+        Scalar toi;
+        Vec2 normal;
+        if ((*targetInfra)[i].sweepCollision(from, to, radius, toi, normal) && toi < hitToi) {
+            hitIndex = i;
+            hitToi = toi;
+            hitNormal = normal;
+        }
+    }
+
+    if (hitIndex < 0) return;
+
+    // Dejar el proyectil en el punto de contacto en vez de dentro del bloque
+    projectile.setScalarPosition(from + (to - from) * hitToi);
+
+    damageInfrastructure(targetPlayer, hitIndex, sideFromNormal(hitNormal), vel);
+
+    // Invertir la componente normal de la velocidad con el coeficiente de
+    // restitucion (en las caras equivale a invertir vx o vy como en el modo discreto)
+    Scalar normalSpeed = vel.x() * hitNormal.x() + vel.y() * hitNormal.y();
+    if (normalSpeed < 0) {
+        vel -= hitNormal * ((1 + Scalar(restitutionCoefficient)) * normalSpeed);
+    }
+
+    projectile.setScalarVelocity(vel);
+    projectile.incrementBounce();
+
+    // Si ya rebotó 3 veces, desactivar
+    if (projectile.getBounceCount() >= 3) {
+        projectile.setActive(false);
+    }
+
+    checkVictoryConditions();
+}
+
+void GameEngine::damageInfrastructure(int targetPlayer, int index, int side, const Vec2& vel)
+{
+    QVector<Infrastructure>& targets = (targetPlayer == 1) ? player1Infrastructure : player2Infrastructure;
+
+    Scalar speed = scalarSqrt(vel.x() * vel.x() + vel.y() * vel.y());
+    Scalar damage = Scalar(damageFactor) * Scalar(projectileMass) * speed;
+
+    if (shotStats.firstHitIndex < 0) {
+        shotStats.firstHitIndex = index;
+    }
+
+    Scalar before = targets[index].getScalarResistance();
+    targets[index].takeDamage(damage);
+    const Scalar dealt = before - targets[index].getScalarResistance();
+    if (dealt != Scalar(0)) touchLayout();
+    shotStats.damageDealt += toDouble(dealt);
+
+    publishEvent(GameEventType::InfrastructureHit, targetPlayer, index, side,
+                 toDouble(dealt), targets[index].getResistance());
+
+    // Un bloque recien destruido sale del indice y del conteo de bloques en pie
+    if (before > 0 && targets[index].isDestroyed()) {
+        if (targetPlayer == 1) {
+            player1Grid.remove(index, targets[index].getRect());
+            player1Alive--;
+        } else {
+            player2Grid.remove(index, targets[index].getRect());
+            player2Alive--;
+        }
+        publishEvent(GameEventType::BlockDestroyed, targetPlayer, index);
+    }
+}
+
+void GameEngine::publishEvent(GameEventType type, int player, int index, int side,
+                              double damage, double resistance)
+{
+    if (eventCallback == nullptr) return;
+
+    GameEvent event;
+    event.type = type;
+    event.player = player;
+    event.index = index;
+    event.side = side;
+    event.damage = damage;
+    event.resistance = resistance;
+    event.step = shotStats.steps;
+    if (eventSlot >= 0 && eventSlot < projectileCount) {
+        event.projectile = eventSlot;
+        event.position = projectiles[eventSlot].getPosition();
+        event.velocity = projectiles[eventSlot].getVelocity();
+
+        // Los choques se publican antes de sumar el rebote al proyectil
+        const bool collision = (type == GameEventType::WallBounce || type == GameEventType::InfrastructureHit ||
+                                type == GameEventType::BlockDestroyed);
+        event.bounces = projectiles[eventSlot].getBounceCount() + (collision ? 1 : 0);
+    }
+    eventCallback(eventContext, event);
+}
+
+void GameEngine::endGame(int winningPlayer)
+{
+    // Con una andanada varios proyectiles pueden cerrar la partida
+    if (gameOver) return;
+
+    gameOver = true;
+    winner = winningPlayer;
+    publishEvent(GameEventType::GameOver, winningPlayer);
+}
+
+void GameEngine::checkVictoryConditions()
+{
+    // Si ya hay un ganador (por golpear al rival)
+    if (gameOver) return;
+
+    bool player1Defeated = (player1Alive == 0);
+    bool player2Defeated = (player2Alive == 0);
+
+    // Solo declarar victoria por destrucción de infraestructura
+    if (player1Defeated) {
+        endGame(2);
+    } else if (player2Defeated) {
+        endGame(1);
+    }
+}
+
+void GameEngine::touchLayout()
+{
+    layoutVersion = layoutVersionCounter.fetch_add(1, std::memory_order_relaxed) + 1;
+}
+
+void GameEngine::switchTurn()
+{
+    // Limpiar los proyectiles del turno anterior
+    projectileCount = 0;
+
+    currentPlayer = (currentPlayer == 1) ? 2 : 1;
+    publishEvent(GameEventType::TurnSwitch, currentPlayer);
+    checkVictoryConditions();
+}
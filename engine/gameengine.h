@@ -0,0 +1,222 @@
+#ifndef GAMEENGINE_H
+#define GAMEENGINE_H
+
+#include "projectile.h"
+#include "infrastructure.h"
+#include "spatialgrid.h"
+#include "gameevents.h"
+#include <QVector>
+#include <QtGlobal>
+#include <type_traits>
+#include <vector>
+
+// Estadisticas del disparo en curso (se reinician en cada lanzamiento)
+struct ShotStats
+{
+    int firstHitIndex = -1;   // Primer bloque enemigo golpeado, -1 si ninguno
+    double damageDealt = 0.0; // Resistencia total quitada al rival
+    int steps = 0;            // Pasos de simulacion del vuelo
+};
+
+// Lo que cambia durante una partida salvo las resistencias: proyectiles,
+// turno y ganador, con la cantidad de bloques de cada jugador. Las
+// resistencias van en un arreglo aparte del que llama (ver
+// GameEngine::snapshot()), asi que sirve para escenarios de cualquier
+// tamaño. La geometria de los bloques y las constantes quedan en el motor:
+// un estado solo se puede restaurar en un motor con el mismo escenario. Es
+// de tamaño fijo y trivialmente copiable.
+struct GameState
+{
+    static constexpr int maxProjectiles = 8;
+
+    int player1Blocks;
+    int player2Blocks;
+
+    int projectileCount;
+    Projectile projectiles[maxProjectiles];
+    ShotStats shotStats;
+
+    int currentPlayer;
+    bool gameOver;
+    int winner;
+};
+
+static_assert(std::is_trivially_copyable<GameState>::value, "GameState se copia con memcpy");
+
+class GameEngine
+{
+public:
+    GameEngine(double width, double height);
+    GameEngine(const GameEngine& other);
+    GameEngine& operator=(const GameEngine& other);
+
+    void addInfrastructure(int player, const Infrastructure& infra);
+    void reserveInfrastructure(int player, int count);
+    void loadDefaultLayout();
+    void launchProjectile(int player, double angle, double speed);
+
+    // Andanada: count proyectiles (hasta maxProjectiles) con los angulos
+    // repartidos en un abanico de spread grados centrado en angle. Todos
+    // avanzan en cada update() y golpean los mismos bloques; los proyectiles
+    // viven en un arreglo fijo del motor, asi que disparar no reserva memoria.
+    void launchVolley(int player, double angle, double speed, int count, double spread);
+    static constexpr int maxProjectiles = GameState::maxProjectiles;
+
+    bool update(double dt);
+
+    // Colision continua: en cada paso se calcula el instante exacto de
+    // contacto con los bloques y la zona del rival a lo largo del recorrido,
+    // de modo que pasos grandes no atraviesan los bloques delgados
+    void setContinuousCollision(bool enabled) { continuousCollision = enabled; }
+    bool isContinuousCollision() const { return continuousCollision; }
+
+    // Modo por eventos: entre choques la trayectoria es una parabola exacta,
+    // asi que en vez de integrar con pasos fijos se calcula analiticamente el
+    // siguiente evento (pared, techo, piso, bloque o zona del rival) y se
+    // salta directamente a el. update(dt) avanza dt resolviendo los eventos
+    // intermedios; advanceToNextEvent() salta al siguiente evento.
+    void setEventDriven(bool enabled) { eventDriven = enabled; }
+    bool isEventDriven() const { return eventDriven; }
+    bool advanceToNextEvent();
+
+    // Metodo de integracion de la fisica por pasos (integrator.h). Euler es
+    // el de siempre y el unico que da las mismas trayectorias que antes.
+    void setIntegrator(Integrator method) { integrator = method; }
+    Integrator getIntegrator() const { return integrator; }
+
+    // Paso adaptativo: update(dt) da el paso entero cuando en dt el proyectil
+    // no puede alcanzar paredes, bloques ni la zona del rival, y si no lo
+    // divide en subpasos que avanzan a lo sumo fineStepDistance pixeles (por
+    // defecto medio radio). Con Integrator::Exact el vuelo libre no pierde
+    // precision con pasos grandes y los choques se resuelven con pasos finos.
+    void setAdaptiveStep(bool enabled) { adaptiveStep = enabled; }
+    bool isAdaptiveStep() const { return adaptiveStep; }
+    void setFineStepDistance(double distance) { fineStepDistance = distance; }
+    double getFineStepDistance() const { return fineStepDistance; }
+
+    int getCurrentPlayer() const { return currentPlayer; }
+    bool isGameOver() const { return gameOver; }
+    int getWinner() const { return winner; }
+    double getBoxWidth() const { return toDouble(boxWidth); }
+    double getBoxHeight() const { return toDouble(boxHeight); }
+    const ShotStats& getShotStats() const { return shotStats; }
+
+    // Geometria del escenario. Por defecto es la del tablero original de
+    // 800x600; un nivel (level.h) la cambia antes de agregar los bloques.
+    double getFloorY() const { return toDouble(floorY); }
+    QPointF getCannonPosition(int player) const { return cannonPositions[player == 2 ? 1 : 0]; }
+    QRectF getRivalZone(int player) const { return toQRectF(rivalZones[player == 2 ? 1 : 0]); }
+    void setFloorY(double y) { floorY = toScalar(y); touchLayout(); }
+    void setCannonPosition(int player, const QPointF& position) { cannonPositions[player == 2 ? 1 : 0] = position; touchLayout(); }
+    void setRivalZone(int player, const QRectF& zone) { rivalZones[player == 2 ? 1 : 0] = toRect(zone); touchLayout(); }
+
+    // Version del escenario: cambia cada vez que cambia la resistencia de
+    // algun bloque (golpes, restore()) o la geometria, y es unica entre
+    // todos los motores del proceso; las copias conservan la del original.
+    // Dos motores con la misma version tienen el mismo escenario.
+    quint64 getLayoutVersion() const { return layoutVersion; }
+
+    // Constantes fisicas de los choques
+    double getRestitutionCoefficient() const { return restitutionCoefficient; }
+    double getDamageFactor() const { return damageFactor; }
+    double getProjectileMass() const { return projectileMass; }
+
+    const QVector<Infrastructure>& getPlayer1Infrastructure() const { return player1Infrastructure; }
+    const QVector<Infrastructure>& getPlayer2Infrastructure() const { return player2Infrastructure; }
+    int getAliveInfrastructureCount(int player) const { return (player == 1) ? player1Alive : player2Alive; }
+
+    // Eventos del juego (lanzamiento, rebotes, golpes, bloques destruidos,
+    // rival alcanzado, cambio de turno y fin del juego). El receptor se llama
+    // en el mismo hilo en cuanto ocurre cada evento; nullptr lo desactiva.
+    // Las copias del motor no heredan el receptor.
+    void setEventCallback(GameEventCallback callback, void* context = nullptr)
+    {
+        eventCallback = callback;
+        eventContext = context;
+    }
+    GameEventCallback getEventCallback() const { return eventCallback; }
+    void* getEventContext() const { return eventContext; }
+
+    // Guarda el estado de la partida, y en resistance la resistencia de cada
+    // bloque (primero los del jugador 1). resistance se ajusta a la cantidad
+    // de bloques: si se guarda siempre en el mismo vector solo reserva
+    // memoria la primera vez.
+    void snapshot(GameState& state, std::vector<double>& resistance) const;
+
+    // Vuelve al estado guardado con las resistencias de snapshot(); devuelve
+    // false si la cantidad de bloques no coincide con la del escenario actual
+    bool restore(const GameState& state, const double* resistance);
+
+    // Para restaurar por partes (StateHistory): la resistencia de un solo
+    // bloque, y todo lo que restore() toma del estado salvo las resistencias
+    void setBlockResistance(int player, int index, double resistance);
+    void restoreMatch(const Projectile* shot, int count, const ShotStats& stats,
+                      int player, bool over, int winningPlayer);
+
+    // El indice espacial se construye solo en la primera consulta tras
+    // agregar bloques; conviene llamarlo antes de copiar el motor muchas veces
+    void buildSpatialIndex();
+    // Primer proyectil del disparo en curso (el unico si no es una andanada)
+    const Projectile* getActiveProjectile() const { return projectileCount > 0 ? &projectiles[0] : nullptr; }
+    int getProjectileCount() const { return projectileCount; }
+    const Projectile& getProjectile(int index) const { return projectiles[index]; }
+    bool hasActiveProjectiles() const;
+    void switchTurn();
+
+private:
+    // Lo que usa la fisica por pasos va en el tipo de scalar.h
+    Scalar boxWidth, boxHeight;
+    Scalar floorY;
+    QPointF cannonPositions[2];
+    Rect rivalZones[2];
+    int currentPlayer;
+    bool gameOver;
+    int winner;
+
+    QVector<Infrastructure> player1Infrastructure;
+    QVector<Infrastructure> player2Infrastructure;
+
+    // Indice espacial y bloques en pie de cada jugador
+    SpatialGrid player1Grid;
+    SpatialGrid player2Grid;
+    int player1Alive;
+    int player2Alive;
+    bool gridsDirty;
+    std::vector<int> candidates;  // Bloques cercanos de la ultima consulta
+
+    GameEventCallback eventCallback;
+    void* eventContext;
+
+    Projectile projectiles[maxProjectiles];
+    int projectileCount;
+    int eventSlot;  // Proyectil que se esta simulando, para los eventos; -1 fuera de los pasos
+    ShotStats shotStats;
+    bool continuousCollision;
+    bool eventDriven;
+    Integrator integrator;
+    bool adaptiveStep;
+    double fineStepDistance;
+    quint64 layoutVersion;
+
+    static constexpr int maxSubSteps = 64;  // Subpasos por proyectil en un update()
+    static constexpr double restitutionCoefficient = 0.6;
+    static constexpr double damageFactor = 0.5;
+    static constexpr double projectileMass = 1.0;
+
+    bool updateProjectile(Projectile& projectile, double dt);
+    void advanceAdaptive(Projectile& projectile, double dt);
+    double adaptiveStepLength(const Projectile& projectile, double remaining);
+    void handleWallCollisions(Projectile& projectile);
+    void handleInfrastructureCollisions(Projectile& projectile);
+    void handleSweptInfrastructureCollisions(Projectile& projectile, const Vec2& from);
+    void damageInfrastructure(int targetPlayer, int index, int side, const Vec2& vel);
+    void publishEvent(GameEventType type, int player, int index = -1, int side = -1,
+                      double damage = 0.0, double resistance = 0.0);
+    void endGame(int winningPlayer);
+    void queryTargets(const QRectF& area);
+    double advanceAnalytic(Projectile& projectile, double maxTime);
+    void checkVictoryConditions();
+    void touchLayout();
+};
+
+#endif // GAMEENGINE_H
@@ -0,0 +1,90 @@
+#ifndef GAMEEVENTS_H
+#define GAMEEVENTS_H
+
+#include <QPointF>
+
+// Lo que paso en el motor, en el orden en que ocurrio
+enum class GameEventType
+{
+    Launch,             // player dispara desde position con velocity
+    WallBounce,         // side: 0 = izquierda, 1 = derecha, 2 = techo, 3 = piso
+    InfrastructureHit,  // player es el dueño del bloque index; side como getCollisionSide
+    BlockDestroyed,     // el bloque index de player llego a resistencia 0
+    RivalHit,           // player golpeo la figura del rival
+    TurnSwitch,         // player es el jugador que tiene el turno ahora
+    GameOver            // player es el ganador
+};
+
+// Evento de tamaño fijo y copiable con memcpy: se puede guardar en
+// arreglos o anillos sin reservar memoria
+struct GameEvent
+{
+    GameEventType type = GameEventType::Launch;
+    int player = 0;
+    int index = -1;
+    int side = -1;
+    double damage = 0.0;     // Resistencia quitada (solo InfrastructureHit)
+    double resistance = 0.0; // Resistencia que le queda al bloque (solo InfrastructureHit)
+    int step = 0;            // Paso de simulacion del disparo en curso
+    int projectile = 0;      // Proyectil de la andanada (0 si es un solo disparo)
+    int bounces = 0;         // Rebotes del proyectil ya contando el choque del evento
+                             // (WallBounce, InfrastructureHit, BlockDestroyed); en una
+                             // esquina los dos WallBounce cuentan como uno, igual que el motor
+    QPointF position;        // Posicion del proyectil al ocurrir el evento
+    QPointF velocity;        // Velocidad del proyectil justo antes del evento
+                             // (sin proyectil, como en TurnSwitch, quedan en 0)
+};
+
+// Receptor de eventos: una funcion y un puntero de contexto, sin
+// std::function para que registrar y publicar no reserven memoria
+typedef void (*GameEventCallback)(void* context, const GameEvent& event);
+
+// Cola circular de capacidad fija para consumir los eventos mas tarde (por
+// ejemplo una vez por cuadro en la interfaz). Si se llena se descartan los
+// mas antiguos y se cuentan en getDropped().
+class GameEventRing
+{
+public:
+    static constexpr int capacity = 256;
+
+    GameEventRing() : head(0), count(0), dropped(0) {}
+
+    // Adaptador para GameEngine::setEventCallback(GameEventRing::collect, &ring)
+    static void collect(void* context, const GameEvent& event)
+    {
+        static_cast<GameEventRing*>(context)->push(event);
+    }
+
+    void push(const GameEvent& event)
+    {
+        if (count == capacity) {
+            head = (head + 1) % capacity;
+            count--;
+            dropped++;
+        }
+        events[(head + count) % capacity] = event;
+        count++;
+    }
+
+    bool pop(GameEvent& event)
+    {
+        if (count == 0) return false;
+        event = events[head];
+        head = (head + 1) % capacity;
+        count--;
+        return true;
+    }
+
+    bool isEmpty() const { return count == 0; }
+    int size() const { return count; }
+    long long getDropped() const { return dropped; }
+    void clear() { head = 0; count = 0; }
+
+private:
+    GameEvent events[capacity];
+    int head;
+    int count;
+    long long dropped;
+};
+
+#endif // GAMEEVENTS_H
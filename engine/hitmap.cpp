@@ -0,0 +1,137 @@
+#include "hitmap.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+QVector<int> HitMap::nextBatch(double focusAngle) const
+{
+    QVector<int> batch;
+    for (int stride = coarsestStride; stride >= 1 && batch.isEmpty(); stride /= 2) {
+        for (int i = 0; i < sampleCount; i += stride) {
+            if (!samples[i].computed) batch.append(i);
+        }
+    }
+
+    const double focus = focusAngle / angleStep;
+    std::stable_sort(batch.begin(), batch.end(), [focus](int a, int b) {
+        return std::abs(a - focus) < std::abs(b - focus);
+    });
+    return batch;
+}
+
+void HitMap::store(int index, const HitSample& sample)
+{
+    if (!sample.computed) return;
+    if (!samples[index].computed) computedCount++;
+    samples[index] = sample;
+}
+
+namespace {
+
+// Guarda la posicion del primer golpe del disparo; los rebotes en las
+// paredes laterales y el techo no cuentan
+struct ImpactProbe
+{
+    bool found = false;
+    QPointF position;
+
+    static void collect(void* context, const GameEvent& event)
+    {
+        ImpactProbe& probe = *static_cast<ImpactProbe*>(context);
+        if (probe.found || event.projectile != 0) return;
+
+        const bool floor = (event.type == GameEventType::WallBounce && event.side == 3);
+        if (floor || event.type == GameEventType::InfrastructureHit ||
+            event.type == GameEventType::RivalHit) {
+            probe.found = true;
+            probe.position = event.position;
+        }
+    }
+};
+
+} // namespace
+
+QVector<HitSample> sampleShots(const GameEngine& state, const QVector<double>& angles, double speed,
+                               double dt, int threadCount, const std::atomic<bool>* cancel)
+{
+    QVector<HitSample> samples(angles.size());
+    if (samples.isEmpty()) return samples;
+
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threadCount = std::max(1, std::min(threadCount, static_cast<int>(angles.size())));
+
+    // Un disparo a la vez por hilo: son pocos y la cancelacion se revisa
+    // entre uno y otro
+    std::atomic<int> next(0);
+    HitSample* out = samples.data();
+
+    auto worker = [&]() {
+        GameEngine base(state);
+        base.buildSpatialIndex();
+        GameEngine engine(base);
+        GameState start;
+        std::vector<double> startResistance;
+        base.snapshot(start, startResistance);
+
+        ImpactProbe probe;
+        for (int i = next.fetch_add(1); i < angles.size(); i = next.fetch_add(1)) {
+            if (cancel && cancel->load(std::memory_order_relaxed)) return;
+
+            if (!engine.restore(start, startResistance.data())) {
+                engine = base;
+            }
+            // Las copias no heredan el receptor
+            engine.setEventCallback(ImpactProbe::collect, &probe);
+            probe.found = false;
+
+            HitSample& sample = out[i];
+            sample.result = runShot(engine, angles[i], speed, dt);
+            sample.impact = probe.found ? probe.position : engine.getProjectile(0).getPosition();
+            sample.computed = true;
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (int t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    return samples;
+}
+
+// FNV-1a de 64 bits
+static void hashBytes(quint64& hash, const void* data, size_t size)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+}
+
+quint64 layoutKey(const GameEngine& state)
+{
+    quint64 hash = 14695981039346656037ull;
+    const int turn[2] = {state.getCurrentPlayer(), state.isGameOver() ? 1 : 0};
+    hashBytes(hash, turn, sizeof(turn));
+
+    for (int player = 1; player <= 2; ++player) {
+        const QVector<Infrastructure>& blocks =
+            (player == 1) ? state.getPlayer1Infrastructure() : state.getPlayer2Infrastructure();
+        const int count = blocks.size();
+        hashBytes(hash, &count, sizeof(count));
+        for (const Infrastructure& block : blocks) {
+            const double resistance = block.getResistance();
+            hashBytes(hash, &resistance, sizeof(resistance));
+        }
+    }
+    return hash;
+}
@@ -0,0 +1,63 @@
+#ifndef HITMAP_H
+#define HITMAP_H
+
+#include "gameengine.h"
+#include "shotrunner.h"
+#include <QPointF>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+
+// Lo que hace un disparo del mapa de golpes
+struct HitSample
+{
+    bool computed = false;
+    ShotResult result;
+    QPointF impact;  // Primer golpe (bloque, rival o piso) o donde se detuvo
+};
+
+// Mapa de golpes a una velocidad: un disparo cada angleStep grados entre 0 y
+// 90, que se calcula por tandas de la rejilla mas gruesa a la mas fina (cada
+// 8 grados, despues cada 4, ... hasta angleStep), asi que con pocas tandas
+// ya se ve la forma del mapa completo
+class HitMap
+{
+public:
+    static constexpr double angleStep = 0.25;
+    static constexpr int sampleCount = 361;  // 90 / angleStep + 1
+    static constexpr int coarsestStride = 32;  // 8 grados, en muestras
+
+    HitMap() : samples(sampleCount), computedCount(0) {}
+
+    double angleAt(int index) const { return index * angleStep; }
+    const HitSample& sample(int index) const { return samples[index]; }
+    int getComputedCount() const { return computedCount; }
+    bool isComplete() const { return computedCount == sampleCount; }
+
+    // Indices de la siguiente tanda: los que faltan de la rejilla mas gruesa
+    // incompleta, empezando por los mas cercanos a focusAngle (el del
+    // slider), que se refinan antes. Vacio si el mapa esta completo.
+    QVector<int> nextBatch(double focusAngle) const;
+
+    void store(int index, const HitSample& sample);
+
+private:
+    QVector<HitSample> samples;
+    int computedCount;
+};
+
+// Simula para el jugador actual de state los disparos a velocidad speed con
+// los angulos angles, repartidos entre threadCount hilos (0 = todos los
+// nucleos), cada uno en su propia copia del motor. Si cancel se pone en true
+// se deja de lanzar disparos y las muestras que faltan quedan sin calcular
+// (computed = false). state no se modifica.
+QVector<HitSample> sampleShots(const GameEngine& state, const QVector<double>& angles, double speed,
+                               double dt = 0.016, int threadCount = 0,
+                               const std::atomic<bool>* cancel = nullptr);
+
+// Huella de lo que cambia el resultado de un disparo durante la partida:
+// turno, fin del juego y resistencia de cada bloque. La geometria del
+// nivel no entra; quien cambie de nivel debe descartar los mapas guardados.
+quint64 layoutKey(const GameEngine& state);
+
+#endif // HITMAP_H
@@ -0,0 +1,181 @@
+#include "infrastructure.h"
+#include <cmath>
+#include <algorithm>
+
+Infrastructure::Infrastructure(double x, double y, double w, double h, double r)
+    : rect(toRect(QRectF(x, y, w, h))), resistance(toScalar(r))
+{
+}
+
+void Infrastructure::takeDamage(Scalar damage)
+{
+    resistance -= damage;
+    if (resistance < 0) resistance = 0;
+}
+
+bool Infrastructure::checkCollision(const Vec2& center, Scalar radius) const
+{
+    if (isDestroyed()) return false;
+
+    Scalar closestX = std::max(rect.left(), std::min(center.x(), rect.right()));
+    Scalar closestY = std::max(rect.top(), std::min(center.y(), rect.bottom()));
+
+    Scalar dx = center.x() - closestX;
+    Scalar dy = center.y() - closestY;
+    Scalar distance = scalarSqrt(dx * dx + dy * dy);
+
+    return distance < radius;
+}
+
+int Infrastructure::getCollisionSide(const Vec2& center, const Vec2& prevCenter) const
+{
+    Scalar distTop = scalarAbs(center.y() - rect.top());
+    Scalar distBottom = scalarAbs(center.y() - rect.bottom());
+    Scalar distLeft = scalarAbs(center.x() - rect.left());
+    Scalar distRight = scalarAbs(center.x() - rect.right());
+
+    Scalar minDist = std::min({distTop, distBottom, distLeft, distRight});
+
+    if (minDist == distTop) return 0;
+    if (minDist == distRight) return 1;
+    if (minDist == distBottom) return 2;
+    return 3;
+}
+
+bool Infrastructure::sweepCollision(const Vec2& start, const Vec2& end, Scalar radius,
+                                    Scalar& toi, Vec2& normal) const
+{
+    if (isDestroyed()) return false;
+    return sweepCircleRect(rect, start, end, radius, toi, normal);
+}
+
+// Interseccion del segmento start + d*t (t en [0, 1]) con un rectangulo:
+// devuelve la t de entrada y el eje por el que entra (0 = x, 1 = y)
+static bool segmentEntersBox(const Vec2& start, const Vec2& d,
+                             Scalar left, Scalar top, Scalar right, Scalar bottom,
+                             Scalar& tEnter, int& axis)
+{
+    // En punto fijo 1e300 satura al extremo del rango
+    Scalar tMin = Scalar(-1e300);
+    Scalar tMax = Scalar(1e300);
+    axis = -1;
+
+    const Scalar s[2] = {start.x(), start.y()};
+    const Scalar dir[2] = {d.x(), d.y()};
+    const Scalar lo[2] = {left, top};
+    const Scalar hi[2] = {right, bottom};
+
+    for (int a = 0; a < 2; ++a) {
+        if (scalarAbs(dir[a]) < scalarEpsilon(1e-12)) {
+            if (s[a] <= lo[a] || s[a] >= hi[a]) return false;
+            continue;
+        }
+
+        Scalar t1 = (lo[a] - s[a]) / dir[a];
+        Scalar t2 = (hi[a] - s[a]) / dir[a];
+        if (t1 > t2) std::swap(t1, t2);
+
+        if (t1 > tMin) {
+            tMin = t1;
+            axis = a;
+        }
+        tMax = std::min(tMax, t2);
+    }
+
+    // Solo cuenta si entra durante el paso (los roces no cuentan)
+    if (axis < 0 || tMin >= tMax || tMin < 0 || tMin > 1) return false;
+
+    tEnter = tMin;
+    return true;
+}
+
+bool Infrastructure::sweepCircleRect(const Rect& rect, const Vec2& start, const Vec2& end,
+                                     Scalar radius, Scalar& toi, Vec2& normal)
+{
+    const Vec2 d = end - start;
+
+    // Descarte rapido: si la caja del recorrido ni siquiera toca el bloque
+    // ensanchado por radius no hay contacto posible
+    if (std::max(start.x(), end.x()) < rect.left() - radius ||
+        std::min(start.x(), end.x()) > rect.right() + radius ||
+        std::max(start.y(), end.y()) < rect.top() - radius ||
+        std::min(start.y(), end.y()) > rect.bottom() + radius) {
+        return false;
+    }
+
+    // Si ya se solapaba al empezar el paso solo cuenta si sigue entrando
+    Scalar closestX = std::max(rect.left(), std::min(start.x(), rect.right()));
+    Scalar closestY = std::max(rect.top(), std::min(start.y(), rect.bottom()));
+    Vec2 away(start.x() - closestX, start.y() - closestY);
+    Scalar distance = scalarSqrt(away.x() * away.x() + away.y() * away.y());
+
+    if (distance < radius) {
+        if (distance > scalarEpsilon(1e-12)) {
+            normal = away / distance;
+        } else {
+            // Centro dentro del bloque: salir por el lado mas cercano
+            Scalar distTop = start.y() - rect.top();
+            Scalar distBottom = rect.bottom() - start.y();
+            Scalar distLeft = start.x() - rect.left();
+            Scalar distRight = rect.right() - start.x();
+            Scalar minDist = std::min({distTop, distBottom, distLeft, distRight});
+
+            if (minDist == distTop) normal = Vec2(0, -1);
+            else if (minDist == distRight) normal = Vec2(1, 0);
+            else if (minDist == distBottom) normal = Vec2(0, 1);
+            else normal = Vec2(-1, 0);
+        }
+
+        if (d.x() * normal.x() + d.y() * normal.y() >= 0) return false;
+        toi = 0;
+        return true;
+    }
+
+    // El circulo toca el rectangulo cuando su centro entra en la suma de
+    // Minkowski: dos rectangulos ensanchados por radius mas cuatro circulos
+    // en las esquinas. El primer contacto es la primera de esas entradas.
+    bool hit = false;
+    Scalar best = 2;
+    Scalar tEnter;
+    int axis;
+
+    if (segmentEntersBox(start, d, rect.left() - radius, rect.top(),
+                         rect.right() + radius, rect.bottom(), tEnter, axis) && tEnter < best) {
+        best = tEnter;
+        hit = true;
+        normal = (axis == 0) ? Vec2(d.x() > 0 ? -1 : 1, 0) : Vec2(0, d.y() > 0 ? -1 : 1);
+    }
+
+    if (segmentEntersBox(start, d, rect.left(), rect.top() - radius,
+                         rect.right(), rect.bottom() + radius, tEnter, axis) && tEnter < best) {
+        best = tEnter;
+        hit = true;
+        normal = (axis == 0) ? Vec2(d.x() > 0 ? -1 : 1, 0) : Vec2(0, d.y() > 0 ? -1 : 1);
+    }
+
+    const Vec2 corners[4] = {rect.topLeft(), Vec2(rect.right(), rect.top()),
+                             Vec2(rect.right(), rect.bottom()), Vec2(rect.left(), rect.bottom())};
+
+    Scalar a = d.x() * d.x() + d.y() * d.y();
+    if (a > scalarEpsilon(1e-24)) {
+        for (const Vec2& corner : corners) {
+            Vec2 m = start - corner;
+            Scalar b = 2 * (m.x() * d.x() + m.y() * d.y());
+            Scalar c = m.x() * m.x() + m.y() * m.y() - radius * radius;
+            Scalar disc = b * b - 4 * a * c;
+            if (disc <= 0) continue;
+
+            Scalar t = (-b - scalarSqrt(disc)) / (2 * a);
+            if (t >= 0 && t <= 1 && t < best) {
+                best = t;
+                hit = true;
+                normal = (start + d * t - corner) / radius;
+            }
+        }
+    }
+
+    if (hit) {
+        toi = best;
+    }
+    return hit;
+}
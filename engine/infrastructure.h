@@ -0,0 +1,41 @@
+#ifndef INFRASTRUCTURE_H
+#define INFRASTRUCTURE_H
+
+#include "scalar.h"
+#include <QRectF>
+#include <QPointF>
+
+class Infrastructure
+{
+public:
+    Infrastructure(double x, double y, double w, double h, double resistance);
+
+    QRectF getRect() const { return toQRectF(rect); }
+    double getResistance() const { return toDouble(resistance); }
+    bool isDestroyed() const { return resistance <= 0; }
+
+    // En el tipo de la fisica (scalar.h)
+    const Rect& getScalarRect() const { return rect; }
+    Scalar getScalarResistance() const { return resistance; }
+
+    void takeDamage(Scalar damage);
+    void setResistance(double value) { resistance = toScalar(value); }
+
+    bool checkCollision(const Vec2& center, Scalar radius) const;
+    int getCollisionSide(const Vec2& center, const Vec2& prevCenter) const;
+
+    // Colision continua: si el circulo que se mueve en linea recta de start a
+    // end toca el bloque, devuelve en toi la fraccion del recorrido (0-1) del
+    // primer contacto y en normal la normal de contacto (hacia fuera del bloque)
+    bool sweepCollision(const Vec2& start, const Vec2& end, Scalar radius,
+                        Scalar& toi, Vec2& normal) const;
+
+    static bool sweepCircleRect(const Rect& rect, const Vec2& start, const Vec2& end,
+                                Scalar radius, Scalar& toi, Vec2& normal);
+
+private:
+    Rect rect;
+    Scalar resistance;
+};
+
+#endif // INFRASTRUCTURE_H
@@ -0,0 +1,37 @@
+#ifndef INTEGRATOR_H
+#define INTEGRATOR_H
+
+#include <cstring>
+
+// Metodo con el que Projectile::update avanza un paso de la fisica por
+// pasos (el modo por eventos siempre usa la solucion exacta de ballistics.h)
+enum class Integrator
+{
+    Euler,            // El de siempre: la posicion avanza con la velocidad del inicio del paso
+    SymplecticEuler,  // Primero la velocidad y con ella la posicion (Euler semi-implicito)
+    VelocityVerlet,   // Posicion con la aceleracion del inicio, velocidad con el promedio
+    RK4,              // Runge-Kutta clasico de cuarto orden
+    Exact             // Parabola cerrada: exacta con gravedad constante para cualquier dt
+};
+
+constexpr int integratorCount = 5;
+
+inline const char* integratorName(Integrator integrator)
+{
+    static const char* names[integratorCount] = {"euler", "simplectico", "verlet", "rk4", "exacto"};
+    return names[static_cast<int>(integrator)];
+}
+
+// Nombre (como integratorName) a metodo; false si no existe
+inline bool integratorFromName(const char* name, Integrator& integrator)
+{
+    for (int i = 0; i < integratorCount; ++i) {
+        if (std::strcmp(name, integratorName(static_cast<Integrator>(i))) == 0) {
+            integrator = static_cast<Integrator>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // INTEGRATOR_H
@@ -0,0 +1,353 @@
+#include "level.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+static const char levelMagic[4] = {'L', '5', 'L', 'V'};
+
+// Cabecera de un nivel empaquetado de size bytes; se copia porque data
+// puede no estar alineado (un QByteArray cualquiera)
+static bool readPackedHeader(const uchar* data, qint64 size, PackedLevelHeader& header)
+{
+    if (size < qint64(sizeof(PackedLevelHeader))) return false;
+    std::memcpy(&header, data, sizeof(PackedLevelHeader));
+
+    if (std::memcmp(header.magic, levelMagic, 4) != 0 || header.version != Level::formatVersion) {
+        return false;
+    }
+    if (!(header.width > 0 && header.height > 0)) return false;
+
+    qint64 blocks = qint64(header.blockCounts[0]) + qint64(header.blockCounts[1]);
+    return size == qint64(sizeof(PackedLevelHeader)) + blocks * qint64(sizeof(PackedBlock));
+}
+
+// Numero con los digitos justos para leerlo de vuelta sin perder precision
+static void appendNumber(QByteArray& out, double value)
+{
+    char buffer[32];
+    int length = std::snprintf(buffer, sizeof(buffer), "%.15g", value);
+    if (std::strtod(buffer, nullptr) != value) {
+        length = std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+    }
+    out.append(' ');
+    out.append(buffer, length);
+}
+
+Level::Level()
+{
+    GameEngine engine(800, 600);
+    engine.loadDefaultLayout();
+    capture(engine);
+}
+
+void Level::capture(const GameEngine& engine)
+{
+    width = engine.getBoxWidth();
+    height = engine.getBoxHeight();
+    floorY = engine.getFloorY();
+    for (int player = 1; player <= 2; ++player) {
+        cannonPositions[player - 1] = engine.getCannonPosition(player);
+        rivalZones[player - 1] = engine.getRivalZone(player);
+    }
+    blocks[0] = engine.getPlayer1Infrastructure();
+    blocks[1] = engine.getPlayer2Infrastructure();
+}
+
+GameEngine Level::createEngine() const
+{
+    GameEngine engine(width, height);
+    engine.setFloorY(floorY);
+    for (int player = 1; player <= 2; ++player) {
+        engine.setCannonPosition(player, cannonPositions[player - 1]);
+        engine.setRivalZone(player, rivalZones[player - 1]);
+
+        engine.reserveInfrastructure(player, blocks[player - 1].size());
+        for (const Infrastructure& block : blocks[player - 1]) {
+            engine.addInfrastructure(player, block);
+        }
+    }
+    engine.buildSpatialIndex();
+    return engine;
+}
+
+QByteArray Level::toText() const
+{
+    QByteArray out;
+    out.reserve(64 * (blocks[0].size() + blocks[1].size()) + 256);
+
+    out.append("arena");
+    appendNumber(out, width);
+    appendNumber(out, height);
+    out.append("\nsuelo");
+    appendNumber(out, floorY);
+    out.append('\n');
+
+    for (int player = 1; player <= 2; ++player) {
+        const QPointF& cannon = cannonPositions[player - 1];
+        const QRectF& zone = rivalZones[player - 1];
+        out.append(player == 1 ? "canon 1" : "canon 2");
+        appendNumber(out, cannon.x());
+        appendNumber(out, cannon.y());
+        out.append(player == 1 ? "\nrival 1" : "\nrival 2");
+        appendNumber(out, zone.x());
+        appendNumber(out, zone.y());
+        appendNumber(out, zone.width());
+        appendNumber(out, zone.height());
+        out.append('\n');
+    }
+
+    for (int player = 1; player <= 2; ++player) {
+        for (const Infrastructure& block : blocks[player - 1]) {
+            QRectF rect = block.getRect();
+            out.append(player == 1 ? "bloque 1" : "bloque 2");
+            appendNumber(out, rect.x());
+            appendNumber(out, rect.y());
+            appendNumber(out, rect.width());
+            appendNumber(out, rect.height());
+            appendNumber(out, block.getResistance());
+            out.append('\n');
+        }
+    }
+
+    return out;
+}
+
+bool Level::parseText(const QByteArray& text, int* errorLine)
+{
+    Level loaded;
+    loaded.blocks[0].clear();
+    loaded.blocks[1].clear();
+
+    // Lo que no aparece se toma del tablero original con el tamaño leido
+    bool floorSet = false;
+    bool cannonSet[2] = {false, false};
+    bool rivalSet[2] = {false, false};
+
+    std::istringstream in(std::string(text.constData(), text.size()));
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        lineNumber++;
+
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream fields(line);
+        std::string command;
+        if (!(fields >> command)) {
+            continue;  // Linea vacia
+        }
+
+        bool valid = false;
+        int player = 0;
+        if (command == "arena") {
+            valid = static_cast<bool>(fields >> loaded.width >> loaded.height) &&
+                    loaded.width > 0 && loaded.height > 0;
+        } else if (command == "suelo") {
+            valid = floorSet = static_cast<bool>(fields >> loaded.floorY);
+        } else if (fields >> player && (player == 1 || player == 2)) {
+            double x, y, w, h, resistance;
+            if (command == "canon" && fields >> x >> y) {
+                loaded.cannonPositions[player - 1] = QPointF(x, y);
+                valid = cannonSet[player - 1] = true;
+            } else if (command == "rival" && fields >> x >> y >> w >> h) {
+                loaded.rivalZones[player - 1] = QRectF(x, y, w, h);
+                valid = rivalSet[player - 1] = true;
+            } else if (command == "bloque" && fields >> x >> y >> w >> h >> resistance) {
+                loaded.blocks[player - 1].append(Infrastructure(x, y, w, h, resistance));
+                valid = true;
+            }
+        }
+
+        std::string extra;
+        if (!valid || fields >> extra) {
+            if (errorLine) *errorLine = lineNumber;
+            return false;
+        }
+    }
+
+    GameEngine defaults(loaded.width, loaded.height);
+    if (!floorSet) loaded.floorY = defaults.getFloorY();
+    for (int player = 1; player <= 2; ++player) {
+        if (!cannonSet[player - 1]) loaded.cannonPositions[player - 1] = defaults.getCannonPosition(player);
+        if (!rivalSet[player - 1]) loaded.rivalZones[player - 1] = defaults.getRivalZone(player);
+    }
+
+    *this = loaded;
+    return true;
+}
+
+QByteArray Level::toPacked() const
+{
+    PackedLevelHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, levelMagic, 4);
+    header.version = formatVersion;
+    header.width = width;
+    header.height = height;
+    header.floorY = floorY;
+    for (int i = 0; i < 2; ++i) {
+        header.cannons[i][0] = cannonPositions[i].x();
+        header.cannons[i][1] = cannonPositions[i].y();
+        header.rivalZones[i][0] = rivalZones[i].x();
+        header.rivalZones[i][1] = rivalZones[i].y();
+        header.rivalZones[i][2] = rivalZones[i].width();
+        header.rivalZones[i][3] = rivalZones[i].height();
+        header.blockCounts[i] = blocks[i].size();
+    }
+
+    QByteArray out(int(sizeof(header) + sizeof(PackedBlock) * (blocks[0].size() + blocks[1].size())), '\0');
+    char* cursor = out.data();
+    std::memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+
+    for (int i = 0; i < 2; ++i) {
+        for (const Infrastructure& block : blocks[i]) {
+            QRectF rect = block.getRect();
+            PackedBlock packed = {rect.x(), rect.y(), rect.width(), rect.height(), block.getResistance()};
+            std::memcpy(cursor, &packed, sizeof(packed));
+            cursor += sizeof(packed);
+        }
+    }
+
+    return out;
+}
+
+bool Level::parsePacked(const char* data, qint64 size)
+{
+    const uchar* bytes = reinterpret_cast<const uchar*>(data);
+    PackedLevelHeader header;
+    if (!readPackedHeader(bytes, size, header)) {
+        return false;
+    }
+
+    width = header.width;
+    height = header.height;
+    floorY = header.floorY;
+
+    const uchar* cursor = bytes + sizeof(header);
+    for (int i = 0; i < 2; ++i) {
+        cannonPositions[i] = QPointF(header.cannons[i][0], header.cannons[i][1]);
+        rivalZones[i] = QRectF(header.rivalZones[i][0], header.rivalZones[i][1],
+                               header.rivalZones[i][2], header.rivalZones[i][3]);
+
+        blocks[i].clear();
+        blocks[i].reserve(header.blockCounts[i]);
+        for (quint32 b = 0; b < header.blockCounts[i]; ++b) {
+            PackedBlock packed;
+            std::memcpy(&packed, cursor, sizeof(packed));
+            cursor += sizeof(packed);
+            blocks[i].append(Infrastructure(packed.x, packed.y, packed.width, packed.height, packed.resistance));
+        }
+    }
+
+    return true;
+}
+
+bool Level::loadFromFile(const QString& path, int* errorLine)
+{
+    if (errorLine) *errorLine = 0;
+
+    MappedLevel mapped;
+    if (mapped.open(path)) {
+        const PackedLevelHeader& header = mapped.getHeader();
+        qint64 size = qint64(sizeof(header)) +
+            qint64(sizeof(PackedBlock)) * (qint64(header.blockCounts[0]) + header.blockCounts[1]);
+        return parsePacked(reinterpret_cast<const char*>(&header), size);
+    }
+
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return parseText(file.readAll(), errorLine);
+}
+
+bool Level::saveToFile(const QString& path, bool packed) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QByteArray data = packed ? toPacked() : toText();
+    return file.write(data) == data.size();
+}
+
+MappedLevel::MappedLevel()
+    : file(QString()), data(nullptr), header(nullptr)
+{
+}
+
+MappedLevel::~MappedLevel()
+{
+    close();
+}
+
+bool MappedLevel::open(const QString& path)
+{
+    close();
+
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    qint64 size = file.size();
+    PackedLevelHeader check;
+    data = (size >= qint64(sizeof(PackedLevelHeader))) ? file.map(0, size) : nullptr;
+    if (!data || !readPackedHeader(data, size, check)) {
+        close();
+        return false;
+    }
+
+    // El mapeo empieza en un limite de pagina: la cabecera y los bloques
+    // quedan alineados y se leen en su lugar
+    header = reinterpret_cast<const PackedLevelHeader*>(data);
+    return true;
+}
+
+void MappedLevel::close()
+{
+    if (data) {
+        file.unmap(data);
+        data = nullptr;
+    }
+    header = nullptr;
+    file.close();
+}
+
+const PackedBlock* MappedLevel::getBlocks(int player) const
+{
+    const PackedBlock* first = reinterpret_cast<const PackedBlock*>(data + sizeof(PackedLevelHeader));
+    return (player == 2) ? first + header->blockCounts[0] : first;
+}
+
+GameEngine MappedLevel::createEngine() const
+{
+    GameEngine engine(header->width, header->height);
+    engine.setFloorY(header->floorY);
+
+    for (int player = 1; player <= 2; ++player) {
+        const double* cannon = header->cannons[player - 1];
+        const double* zone = header->rivalZones[player - 1];
+        engine.setCannonPosition(player, QPointF(cannon[0], cannon[1]));
+        engine.setRivalZone(player, QRectF(zone[0], zone[1], zone[2], zone[3]));
+
+        const PackedBlock* blocks = getBlocks(player);
+        int count = getBlockCount(player);
+        engine.reserveInfrastructure(player, count);
+        for (int i = 0; i < count; ++i) {
+            engine.addInfrastructure(player, Infrastructure(blocks[i].x, blocks[i].y, blocks[i].width,
+                                                            blocks[i].height, blocks[i].resistance));
+        }
+    }
+
+    engine.buildSpatialIndex();
+    return engine;
+}
@@ -0,0 +1,106 @@
+#ifndef LEVEL_H
+#define LEVEL_H
+
+#include "gameengine.h"
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <QVector>
+#include <type_traits>
+
+// Formato binario empaquetado de un nivel: la cabecera y despues los
+// bloques del jugador 1 y los del jugador 2, todo en el orden de bytes del
+// equipo (little endian en x86 y ARM; en otro orden la version no coincide
+// y el archivo se rechaza). Los bloques quedan alineados a 8 bytes, asi que
+// un archivo mapeado en memoria se usa directamente sin leerlo.
+struct PackedBlock
+{
+    double x, y, width, height;
+    double resistance;
+};
+
+struct PackedLevelHeader
+{
+    char magic[4];           // "L5LV"
+    quint32 version;
+    double width, height;    // Caja de la simulacion
+    double floorY;
+    double cannons[2][2];    // x, y del cañon de cada jugador
+    double rivalZones[2][4]; // x, y, w, h de la zona del rival de cada jugador
+    quint32 blockCounts[2];
+};
+
+static_assert(sizeof(PackedBlock) == 40, "PackedBlock se escribe tal cual");
+static_assert(sizeof(PackedLevelHeader) % alignof(PackedBlock) == 0, "Los bloques van alineados");
+static_assert(std::is_trivially_copyable<PackedLevelHeader>::value, "La cabecera se escribe tal cual");
+
+// Nivel: tamaño de la caja, altura del suelo, cañones, zonas de los rivales
+// y cualquier cantidad de bloques por jugador. Se guarda como texto legible
+// o en el formato empaquetado.
+//
+// Formato de texto: una orden por linea, '#' inicia un comentario.
+//   arena <ancho> <alto>
+//   suelo <y>
+//   canon <jugador> <x> <y>
+//   rival <jugador> <x> <y> <ancho> <alto>
+//   bloque <jugador> <x> <y> <ancho> <alto> <resistencia>
+// Lo que no aparece queda como en el tablero original.
+class Level
+{
+public:
+    static constexpr quint32 formatVersion = 1;
+
+    // Tablero original: 800x600 con el escenario de loadDefaultLayout()
+    Level();
+
+    double width, height;
+    double floorY;
+    QPointF cannonPositions[2];
+    QRectF rivalZones[2];
+    QVector<Infrastructure> blocks[2];
+
+    // Copia la geometria y los bloques de un motor
+    void capture(const GameEngine& engine);
+
+    // Motor listo para jugar con este nivel (con el indice espacial construido)
+    GameEngine createEngine() const;
+
+    QByteArray toText() const;
+    bool parseText(const QByteArray& text, int* errorLine = nullptr);
+
+    QByteArray toPacked() const;
+    bool parsePacked(const char* data, qint64 size);
+
+    // Detecta el formato por los primeros bytes; el empaquetado se mapea
+    bool loadFromFile(const QString& path, int* errorLine = nullptr);
+    bool saveToFile(const QString& path, bool packed) const;
+};
+
+// Nivel empaquetado mapeado en memoria: la cabecera y los bloques se leen
+// directamente del archivo, sin copiarlos ni interpretarlos. Los punteros
+// son validos hasta close() o la destruccion del objeto.
+class MappedLevel
+{
+public:
+    MappedLevel();
+    ~MappedLevel();
+    MappedLevel(const MappedLevel&) = delete;
+    MappedLevel& operator=(const MappedLevel&) = delete;
+
+    bool open(const QString& path);  // false si no es un nivel empaquetado valido
+    void close();
+    bool isOpen() const { return header != nullptr; }
+
+    const PackedLevelHeader& getHeader() const { return *header; }
+    int getBlockCount(int player) const { return header->blockCounts[player == 2 ? 1 : 0]; }
+    const PackedBlock* getBlocks(int player) const;
+
+    GameEngine createEngine() const;
+
+private:
+    QFile file;
+    uchar* data;
+    const PackedLevelHeader* header;
+};
+
+#endif // LEVEL_H
@@ -0,0 +1,185 @@
+#include "profiler.h"
+#include <QFile>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+typedef std::chrono::steady_clock ProfilerClock;
+
+static qint64 clockNanoseconds()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        ProfilerClock::now().time_since_epoch()).count();
+}
+
+// Sondas abiertas de cada categoria en este hilo, para saber cual es la
+// mas externa
+static thread_local int scopeDepth[3] = {0, 0, 0};
+
+// Numero corto de hilo para la traza (1 = el primero que grabo algo)
+static quint32 currentThread()
+{
+    static std::atomic<quint32> nextThread(1);
+    static thread_local quint32 thread = nextThread.fetch_add(1, std::memory_order_relaxed);
+    return thread;
+}
+
+Profiler& Profiler::instance()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler()
+    : active(false), tracing(false), origin(clockNanoseconds()), droppedEvents(0),
+    frameCount(0), frameNext(0), lastFrame(-1)
+{
+    for (std::atomic<qint64>& time : categoryTime) {
+        time.store(0, std::memory_order_relaxed);
+    }
+}
+
+qint64 Profiler::now() const
+{
+    return clockNanoseconds() - origin;
+}
+
+void Profiler::record(const char* name, ProfileCategory category, qint64 start, qint64 duration, bool outermost)
+{
+    if (outermost) {
+        categoryTime[static_cast<int>(category)].fetch_add(duration, std::memory_order_relaxed);
+    }
+
+    if (!tracing.load(std::memory_order_relaxed)) return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (traceEvents.size() >= maxTraceEvents) {
+        droppedEvents++;
+        return;
+    }
+    traceEvents.push_back({name, category, currentThread(), start, duration});
+}
+
+void Profiler::markFrame()
+{
+    if (!isEnabled()) {
+        lastFrame = -1;
+        return;
+    }
+
+    qint64 time = now();
+    qint64 simulation = categoryTime[static_cast<int>(ProfileCategory::Simulation)].exchange(0);
+    qint64 render = categoryTime[static_cast<int>(ProfileCategory::Render)].exchange(0);
+    categoryTime[static_cast<int>(ProfileCategory::Other)].store(0);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (lastFrame >= 0) {
+        frameTimes[frameNext] = (time - lastFrame) / 1e6;
+        frameSimulation[frameNext] = simulation / 1e6;
+        frameRender[frameNext] = render / 1e6;
+        frameNext = (frameNext + 1) % frameHistory;
+        frameCount = std::min(frameCount + 1, int(frameHistory));
+    }
+    lastFrame = time;
+}
+
+FrameStats Profiler::getFrameStats() const
+{
+    FrameStats stats;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (frameCount == 0) return stats;
+
+    std::vector<double> sorted(frameTimes, frameTimes + frameCount);
+    double total = 0, simulation = 0, render = 0;
+    for (int i = 0; i < frameCount; ++i) {
+        total += frameTimes[i];
+        simulation += frameSimulation[i];
+        render += frameRender[i];
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+    stats.frames = frameCount;
+    stats.fps = total > 0 ? 1000.0 * frameCount / total : 0.0;
+    stats.p50 = sorted[(frameCount - 1) / 2];
+    stats.p99 = sorted[std::min(frameCount - 1, static_cast<int>(frameCount * 0.99))];
+    stats.simulationMs = simulation / frameCount;
+    stats.renderMs = render / frameCount;
+    return stats;
+}
+
+void Profiler::startTrace()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    traceEvents.clear();
+    traceEvents.reserve(1 << 16);
+    droppedEvents = 0;
+    tracing.store(true, std::memory_order_relaxed);
+}
+
+QByteArray Profiler::stopTrace()
+{
+    std::vector<TraceEvent> events;
+    long long dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tracing.store(false, std::memory_order_relaxed);
+        events.swap(traceEvents);
+        dropped = droppedEvents;
+    }
+
+    static const char* categoryNames[] = {"simulacion", "dibujo", "otro"};
+
+    // Eventos completos ("ph":"X") con tiempos en microsegundos
+    QByteArray json;
+    json.reserve(static_cast<int>(events.size()) * 96 + 128);
+    json.append("{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":");
+    json.append(QByteArray::number(dropped));
+    json.append("},\"traceEvents\":[\n");
+
+    char buffer[256];
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& event = events[i];
+        int length = std::snprintf(buffer, sizeof(buffer),
+                                   "%s{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,"
+                                   "\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}\n",
+                                   i == 0 ? "" : ",", event.name,
+                                   categoryNames[static_cast<int>(event.category)],
+                                   event.thread, event.start / 1000.0, event.duration / 1000.0);
+        json.append(buffer, std::min(length, int(sizeof(buffer)) - 1));
+    }
+    json.append("]}\n");
+    return json;
+}
+
+bool Profiler::stopTrace(const QString& path)
+{
+    QByteArray json = stopTrace();
+
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+    return file.write(json) == json.size();
+}
+
+ProfileScope::ProfileScope(const char* name, ProfileCategory category)
+    : name(name), category(category), start(-1)
+{
+    Profiler& profiler = Profiler::instance();
+    if (profiler.isEnabled()) {
+        scopeDepth[static_cast<int>(category)]++;
+        start = profiler.now();
+    }
+}
+
+ProfileScope::~ProfileScope()
+{
+    if (start < 0) return;
+
+    Profiler& profiler = Profiler::instance();
+    qint64 end = profiler.now();
+    int& depth = scopeDepth[static_cast<int>(category)];
+    depth--;
+    profiler.record(name, category, start, end - start, depth == 0);
+}
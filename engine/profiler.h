@@ -0,0 +1,124 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <QByteArray>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+// Sondas de tiempo por bloques de codigo. Solo existen si se compila con
+// ENGINE_PROFILING (lo activan las compilaciones debug o "qmake
+// CONFIG+=profiling"); en release PROFILE_SCOPE y PROFILE_FRAME no generan
+// codigo. Con las sondas compiladas pero el perfilador desactivado cada
+// sonda cuesta una lectura atomica.
+//
+//   PROFILE_SCOPE("GameEngine::update", ProfileCategory::Simulation);
+//
+// Cada categoria suma el tiempo de sus sondas mas externas de cada cuadro
+// (una sonda dentro de otra de la misma categoria no cuenta dos veces).
+// Las sondas pueden usarse desde cualquier hilo.
+enum class ProfileCategory
+{
+    Simulation,
+    Render,
+    Other
+};
+
+// Estadisticas de los ultimos cuadros (tiempos en milisegundos)
+struct FrameStats
+{
+    int frames = 0;
+    double fps = 0.0;
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double simulationMs = 0.0;  // Promedio por cuadro
+    double renderMs = 0.0;      // Promedio por cuadro
+};
+
+class Profiler
+{
+public:
+    static constexpr int frameHistory = 240;
+    static constexpr size_t maxTraceEvents = 2000000;
+
+    static Profiler& instance();
+
+    void setEnabled(bool enabled) { active.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return active.load(std::memory_order_relaxed); }
+
+    // Nanosegundos desde que se creo el perfilador (reloj monotono)
+    qint64 now() const;
+
+    void record(const char* name, ProfileCategory category, qint64 start, qint64 duration, bool outermost);
+
+    // Marca el inicio de un cuadro: cierra el anterior con su duracion y el
+    // tiempo de simulacion y de dibujo acumulado desde entonces
+    void markFrame();
+    FrameStats getFrameStats() const;
+
+    // Traza en el formato de eventos de Chrome (chrome://tracing, Perfetto)
+    void startTrace();
+    bool isTracing() const { return tracing.load(std::memory_order_relaxed); }
+    QByteArray stopTrace();  // JSON con los eventos grabados desde startTrace()
+    bool stopTrace(const QString& path);
+
+private:
+    struct TraceEvent
+    {
+        const char* name;
+        ProfileCategory category;
+        quint32 thread;
+        qint64 start;
+        qint64 duration;
+    };
+
+    Profiler();
+
+    std::atomic<bool> active;
+    std::atomic<bool> tracing;
+    qint64 origin;
+
+    // Tiempo de las sondas externas de cada categoria en el cuadro actual
+    std::atomic<qint64> categoryTime[3];
+
+    mutable std::mutex mutex;
+    std::vector<TraceEvent> traceEvents;
+    long long droppedEvents;
+
+    double frameTimes[frameHistory];
+    double frameSimulation[frameHistory];
+    double frameRender[frameHistory];
+    int frameCount;
+    int frameNext;
+    qint64 lastFrame;
+};
+
+// Mide desde la construccion hasta el final del bloque
+class ProfileScope
+{
+public:
+    ProfileScope(const char* name, ProfileCategory category);
+    ~ProfileScope();
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* name;
+    ProfileCategory category;
+    qint64 start;  // -1 si el perfilador estaba desactivado
+};
+
+#ifdef ENGINE_PROFILING
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name, category) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name, category)
+#define PROFILE_FRAME() Profiler::instance().markFrame()
+#else
+#define PROFILE_SCOPE(name, category) do {} while (0)
+#define PROFILE_FRAME() do {} while (0)
+#endif
+
+#endif // PROFILER_H
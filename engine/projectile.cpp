@@ -0,0 +1,98 @@
+#include "projectile.h"
+#include <cmath>
+#include <QDebug>
+
+Projectile::Projectile()
+    : position(0, 0), velocity(0, 0), mass(1), radius(8), active(false), bounceCount(0)
+{
+}
+
+Projectile::Projectile(double x, double y, double angle, double speed, double m, int player)
+    : position(toScalar(x), toScalar(y)), mass(toScalar(m)), radius(8), active(true), bounceCount(0)
+{
+    // En punto fijo el seno y el coseno salen de la tabla de fixedpoint.cpp
+    const Scalar v = toScalar(speed);
+    const Scalar cosine = scalarCosDegrees(angle);
+    const Scalar sine = scalarSinDegrees(angle);
+
+    // Si es jugador 2, invertir la dirección horizontal
+    if (player == 2) {
+        velocity.setX(-v * cosine);
+        velocity.setY(-v * sine);
+    } else {
+        velocity.setX(v * cosine);
+        velocity.setY(-v * sine);
+    }
+}
+
+void Projectile::update(double dt)
+{
+    update(dt, Integrator::Euler);
+}
+
+void Projectile::update(double dt, Integrator integrator)
+{
+    if (!active) return;
+
+    const Scalar step = toScalar(dt);
+    const Scalar g = Scalar(gravity);
+
+    switch (integrator) {
+    case Integrator::Euler:
+        position.setX(position.x() + velocity.x() * step);
+        position.setY(position.y() + velocity.y() * step);
+
+        velocity.setY(velocity.y() + g * step);
+        break;
+
+    case Integrator::SymplecticEuler:
+        velocity.setY(velocity.y() + g * step);
+
+        position.setX(position.x() + velocity.x() * step);
+        position.setY(position.y() + velocity.y() * step);
+        break;
+
+    case Integrator::VelocityVerlet: {
+        // La aceleracion no depende de la posicion, pero se evalua en los dos
+        // extremos como haria con cualquier otra fuerza
+        const Scalar halfStep = step / 2;
+        const Vec2 a0 = acceleration(position);
+        position = position + velocity * step + a0 * (step * halfStep);
+        const Vec2 a1 = acceleration(position);
+        velocity = velocity + (a0 + a1) * halfStep;
+        break;
+    }
+
+    case Integrator::RK4: {
+        // Estado (p, v) con dp/dt = v y dv/dt = a(p)
+        const Scalar halfStep = step / 2;
+        const Scalar sixthStep = step / 6;
+
+        const Vec2 k1p = velocity;
+        const Vec2 k1v = acceleration(position);
+        const Vec2 k2p = velocity + k1v * halfStep;
+        const Vec2 k2v = acceleration(position + k1p * halfStep);
+        const Vec2 k3p = velocity + k2v * halfStep;
+        const Vec2 k3v = acceleration(position + k2p * halfStep);
+        const Vec2 k4p = velocity + k3v * step;
+        const Vec2 k4v = acceleration(position + k3p * step);
+
+        position = position + (k1p + k2p * 2 + k3p * 2 + k4p) * sixthStep;
+        velocity = velocity + (k1v + k2v * 2 + k3v * 2 + k4v) * sixthStep;
+        break;
+    }
+
+    case Integrator::Exact:
+        // Misma parabola que ballistics::positionAt y velocityAt
+        position.setX(position.x() + velocity.x() * step);
+        position.setY(position.y() + velocity.y() * step + g * step * step / 2);
+
+        velocity.setY(velocity.y() + g * step);
+        break;
+    }
+}
+
+Vec2 Projectile::acceleration(const Vec2& /*at*/)
+{
+    return Vec2(0, Scalar(gravity));
+}
@@ -0,0 +1,50 @@
+#ifndef PROJECTILE_H
+#define PROJECTILE_H
+
+#include "integrator.h"
+#include "scalar.h"
+#include <QPointF>
+
+class Projectile
+{
+public:
+    Projectile();  // Inactivo, en el origen
+    Projectile(double x, double y, double angle, double speed, double mass, int player);
+
+    QPointF getPosition() const { return toQPointF(position); }
+    QPointF getVelocity() const { return toQPointF(velocity); }
+    double getMass() const { return toDouble(mass); }
+    double getRadius() const { return toDouble(radius); }
+    bool isActive() const { return active; }
+    static constexpr double getGravity() { return gravity; }
+    int getBounceCount() const { return bounceCount; }
+
+    void setPosition(const QPointF& pos) { position = toVec2(pos); }
+    void setVelocity(const QPointF& vel) { velocity = toVec2(vel); }
+    void setActive(bool a) { active = a; }
+    void incrementBounce() { bounceCount++; }
+
+    // Estado en el tipo de la fisica (scalar.h); las versiones de arriba
+    // convierten cuando el motor se compila en punto fijo
+    const Vec2& getScalarPosition() const { return position; }
+    const Vec2& getScalarVelocity() const { return velocity; }
+    Scalar getScalarRadius() const { return radius; }
+    void setScalarPosition(const Vec2& pos) { position = pos; }
+    void setScalarVelocity(const Vec2& vel) { velocity = vel; }
+
+    void update(double dt);  // Con Integrator::Euler
+    void update(double dt, Integrator integrator);
+
+private:
+    static Vec2 acceleration(const Vec2& at);  // Solo la gravedad
+
+    Vec2 position;
+    Vec2 velocity;
+    Scalar mass;
+    Scalar radius;
+    bool active;
+    int bounceCount;  // NUEVO: Contador de rebotes
+    static constexpr double gravity = 150.0;
+};
+
+#endif // PROJECTILE_H
@@ -0,0 +1,472 @@
+#include "projectilebatch.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+const std::uint64_t laneOn = ~std::uint64_t(0);
+
+// Operaciones por carril para el kernel vectorial. Las mascaras son dobles
+// con todos los bits a uno (verdadero) o a cero (falso), como las que
+// devuelven las comparaciones de SSE/AVX.
+#if defined(__AVX2__)
+
+struct Lanes
+{
+    typedef __m256d V;
+    static constexpr int width = 4;
+
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static V loadMask(const std::uint64_t* p) { return _mm256_loadu_pd(reinterpret_cast<const double*>(p)); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+    static void storeMask(std::uint64_t* p, V v) { _mm256_storeu_pd(reinterpret_cast<double*>(p), v); }
+    static V set(double a) { return _mm256_set1_pd(a); }
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+    static V neg(V a) { return _mm256_xor_pd(a, _mm256_set1_pd(-0.0)); }
+    static V lt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static V le(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); }
+    static V gt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); }
+    static V ge(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+    static V bitAnd(V a, V b) { return _mm256_and_pd(a, b); }
+    static V bitOr(V a, V b) { return _mm256_or_pd(a, b); }
+    static V andNot(V a, V b) { return _mm256_andnot_pd(a, b); }  // ~a & b
+    static V select(V mask, V a, V b) { return _mm256_blendv_pd(b, a, mask); }  // mask ? a : b
+    static int bits(V mask) { return _mm256_movemask_pd(mask); }
+};
+
+#define PROJECTILEBATCH_SIMD
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+struct Lanes
+{
+    typedef __m128d V;
+    static constexpr int width = 2;
+
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static V loadMask(const std::uint64_t* p) { return _mm_loadu_pd(reinterpret_cast<const double*>(p)); }
+    static void store(double* p, V v) { _mm_storeu_pd(p, v); }
+    static void storeMask(std::uint64_t* p, V v) { _mm_storeu_pd(reinterpret_cast<double*>(p), v); }
+    static V set(double a) { return _mm_set1_pd(a); }
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V min(V a, V b) { return _mm_min_pd(a, b); }
+    static V max(V a, V b) { return _mm_max_pd(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_pd(a); }
+    static V neg(V a) { return _mm_xor_pd(a, _mm_set1_pd(-0.0)); }
+    static V lt(V a, V b) { return _mm_cmplt_pd(a, b); }
+    static V le(V a, V b) { return _mm_cmple_pd(a, b); }
+    static V gt(V a, V b) { return _mm_cmpgt_pd(a, b); }
+    static V ge(V a, V b) { return _mm_cmpge_pd(a, b); }
+    static V bitAnd(V a, V b) { return _mm_and_pd(a, b); }
+    static V bitOr(V a, V b) { return _mm_or_pd(a, b); }
+    static V andNot(V a, V b) { return _mm_andnot_pd(a, b); }  // ~a & b
+    static V select(V mask, V a, V b) { return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b)); }
+    static int bits(V mask) { return _mm_movemask_pd(mask); }
+};
+
+#define PROJECTILEBATCH_SIMD
+
+#endif
+
+} // namespace
+
+ProjectileBatch::ProjectileBatch(const GameEngine& prototype)
+    : boxWidth(prototype.getBoxWidth()), boxHeight(prototype.getBoxHeight()),
+    floorY(prototype.getFloorY()), radius(0),
+    restitution(prototype.getRestitutionCoefficient()),
+    damageFactor(prototype.getDamageFactor()), mass(prototype.getProjectileMass()),
+    shooter(prototype.getCurrentPlayer()), aliveTargets(0),
+    count(0), liveCount(0), stepIndex(0)
+{
+    cannon = prototype.getCannonPosition(shooter);
+    rivalZone = prototype.getRivalZone(shooter == 1 ? 2 : 1);
+    radius = Projectile(cannon.x(), cannon.y(), 0, 0, mass, shooter).getRadius();
+
+    const QVector<Infrastructure>& targets = (shooter == 1)
+        ? prototype.getPlayer2Infrastructure()
+        : prototype.getPlayer1Infrastructure();
+
+    for (int i = 0; i < targets.size(); ++i) {
+        if (targets[i].isDestroyed()) continue;
+
+        QRectF rect = targets[i].getRect();
+        blockLeft.push_back(rect.left());
+        blockTop.push_back(rect.top());
+        blockRight.push_back(rect.right());
+        blockBottom.push_back(rect.bottom());
+        blockResistance.push_back(targets[i].getResistance());
+        blockIndex.push_back(i);
+    }
+    aliveTargets = static_cast<int>(blockIndex.size());
+}
+
+void ProjectileBatch::reserve(int n)
+{
+    x.reserve(n);
+    y.reserve(n);
+    vx.reserve(n);
+    vy.reserve(n);
+    active.reserve(n);
+    bounce.reserve(n);
+    steps.reserve(n);
+    winner.reserve(n);
+    hitCount.reserve(n);
+    hitBlock.reserve(n * maxHits);
+    hitDamage.reserve(n * maxHits);
+}
+
+void ProjectileBatch::clear()
+{
+    count = 0;
+    liveCount = 0;
+    stepIndex = 0;
+    x.clear();
+    y.clear();
+    vx.clear();
+    vy.clear();
+    active.clear();
+    bounce.clear();
+    steps.clear();
+    winner.clear();
+    hitCount.clear();
+    hitBlock.clear();
+    hitDamage.clear();
+}
+
+int ProjectileBatch::add(double angle, double speed)
+{
+    // Mismo calculo de velocidad inicial que GameEngine::launchProjectile
+    Projectile p(cannon.x(), cannon.y(), angle, speed, mass, shooter);
+
+    x.push_back(p.getPosition().x());
+    y.push_back(p.getPosition().y());
+    vx.push_back(p.getVelocity().x());
+    vy.push_back(p.getVelocity().y());
+    active.push_back(laneOn);
+    bounce.push_back(0);
+    steps.push_back(0);
+    winner.push_back(0);
+    hitCount.push_back(0);
+    hitBlock.insert(hitBlock.end(), maxHits, -1);
+    hitDamage.insert(hitDamage.end(), maxHits, 0.0);
+
+    liveCount++;
+    return count++;
+}
+
+void ProjectileBatch::deactivate(int i)
+{
+    active[i] = 0;
+    liveCount--;
+    steps[i] = stepIndex;
+}
+
+void ProjectileBatch::registerBounce(int i)
+{
+    bounce[i]++;
+
+    // Si ya rebotó 3 veces, desactivar el proyectil
+    if (bounce[i] >= 3) {
+        deactivate(i);
+    }
+}
+
+double ProjectileBatch::remainingResistance(int i, int block) const
+{
+    // Se repiten las mismas restas que Infrastructure::takeDamage para que
+    // el redondeo coincida con el del motor
+    double resistance = blockResistance[block];
+    const int* blocks = &hitBlock[i * maxHits];
+    const double* damages = &hitDamage[i * maxHits];
+
+    for (int h = 0; h < hitCount[i]; ++h) {
+        if (blocks[h] == block) {
+            resistance -= damages[h];
+            if (resistance < 0) resistance = 0;
+        }
+    }
+    return resistance;
+}
+
+bool ProjectileBatch::resolveHit(int i, int block)
+{
+    double before = remainingResistance(i, block);
+    if (before <= 0) return false;  // Ya destruido por este mismo proyectil
+
+    // Lado del choque: el borde mas cercano al centro (Infrastructure::getCollisionSide)
+    double distTop = std::abs(y[i] - blockTop[block]);
+    double distBottom = std::abs(y[i] - blockBottom[block]);
+    double distLeft = std::abs(x[i] - blockLeft[block]);
+    double distRight = std::abs(x[i] - blockRight[block]);
+    double minDist = std::min({distTop, distBottom, distLeft, distRight});
+
+    double speed = std::sqrt(vx[i] * vx[i] + vy[i] * vy[i]);
+    double damage = damageFactor * mass * speed;
+
+    int h = hitCount[i]++;
+    hitBlock[i * maxHits + h] = block;
+    hitDamage[i * maxHits + h] = damage;
+
+    // Lados 0 (arriba) y 2 (abajo) invierten vy; 1 y 3 invierten vx
+    bool horizontalFace = (minDist == distTop) || (minDist != distRight && minDist == distBottom);
+    if (horizontalFace) {
+        vy[i] = -vy[i] * restitution;
+    } else {
+        vx[i] = -vx[i] * restitution;
+    }
+
+    // Victoria si este proyectil acaba de destruir el ultimo bloque enemigo
+    if (remainingResistance(i, block) <= 0) {
+        int destroyed = 0;
+        for (int b = 0; b < aliveTargets; ++b) {
+            if (remainingResistance(i, b) <= 0) destroyed++;
+        }
+        if (destroyed == aliveTargets) {
+            winner[i] = shooter;
+        }
+    }
+
+    registerBounce(i);
+    return true;
+}
+
+void ProjectileBatch::stepInfrastructure(int i)
+{
+    for (int b = 0; b < aliveTargets; ++b) {
+        double closestX = std::max(blockLeft[b], std::min(x[i], blockRight[b]));
+        double closestY = std::max(blockTop[b], std::min(y[i], blockBottom[b]));
+        double dx = x[i] - closestX;
+        double dy = y[i] - closestY;
+
+        if (std::sqrt(dx * dx + dy * dy) < radius && resolveHit(i, b)) {
+            break;
+        }
+    }
+}
+
+void ProjectileBatch::stepScalar(int i, double dt)
+{
+    if (!active[i]) return;
+
+    // Projectile::update
+    x[i] = x[i] + vx[i] * dt;
+    y[i] = y[i] + vy[i] * dt;
+    vy[i] = vy[i] + Projectile::getGravity() * dt;
+
+    if (x[i] < -100 || x[i] > boxWidth + 100 || y[i] < -100 || y[i] > boxHeight + 100) {
+        deactivate(i);
+        return;
+    }
+
+    // El motor compara con boxHeight + 50 la posicion de antes de los choques
+    const double stepY = y[i];
+
+    if (rivalZone.contains(QPointF(x[i], y[i]))) {
+        winner[i] = shooter;
+        deactivate(i);
+        return;
+    }
+
+    // GameEngine::handleWallCollisions
+    bool collided = false;
+    if (x[i] - radius <= 0) {
+        vx[i] = -vx[i];
+        x[i] = radius;
+        collided = true;
+    } else if (x[i] + radius >= boxWidth) {
+        vx[i] = -vx[i];
+        x[i] = boxWidth - radius;
+        collided = true;
+    }
+    if (y[i] - radius <= 0) {
+        vy[i] = -vy[i];
+        y[i] = radius;
+        collided = true;
+    }
+    if (y[i] + radius >= floorY) {
+        vy[i] = -vy[i] * 0.8;
+        y[i] = floorY - radius;
+        collided = true;
+    }
+    if (collided) {
+        registerBounce(i);
+        if (!active[i]) return;
+    }
+
+    stepInfrastructure(i);
+    if (!active[i]) return;
+
+    if (stepY > boxHeight + 50) {
+        deactivate(i);
+    }
+}
+
+bool ProjectileBatch::step(double dt)
+{
+    stepIndex++;
+    int i = 0;
+
+#ifdef PROJECTILEBATCH_SIMD
+    typedef Lanes L;
+    typedef L::V V;
+
+    const V vdt = L::set(dt);
+    const V vgdt = L::set(Projectile::getGravity() * dt);
+    const V vradius = L::set(radius);
+    const V minX = L::set(-100), maxX = L::set(boxWidth + 100);
+    const V minY = L::set(-100), maxY = L::set(boxHeight + 100);
+    const V zoneLeft = L::set(rivalZone.left()), zoneRight = L::set(rivalZone.right());
+    const V zoneTop = L::set(rivalZone.top()), zoneBottom = L::set(rivalZone.bottom());
+    const V wallRight = L::set(boxWidth), floor = L::set(floorY);
+    const V rightX = L::set(boxWidth - radius), floorRest = L::set(floorY - radius);
+    const V zero = L::set(0), floorDamping = L::set(0.8);
+    const V lateY = L::set(boxHeight + 50);
+
+    for (; i + L::width <= count; i += L::width) {
+        V act = L::loadMask(&active[i]);
+        if (L::bits(act) == 0) continue;
+
+        V px = L::load(&x[i]);
+        V py = L::load(&y[i]);
+        V pvx = L::load(&vx[i]);
+        V pvy = L::load(&vy[i]);
+
+        // Integracion (Projectile::update) solo en carriles activos
+        px = L::select(act, L::add(px, L::mul(pvx, vdt)), px);
+        py = L::select(act, L::add(py, L::mul(pvy, vdt)), py);
+        pvy = L::select(act, L::add(pvy, vgdt), pvy);
+        const V stepY = py;  // Para lateY, antes de apoyarlo en el piso
+
+        // Fuera de limites y zona del rival
+        V out = L::bitOr(L::bitOr(L::lt(px, minX), L::gt(px, maxX)),
+                         L::bitOr(L::lt(py, minY), L::gt(py, maxY)));
+        out = L::bitAnd(out, act);
+        act = L::andNot(out, act);
+
+        V won = L::bitAnd(L::bitAnd(L::ge(px, zoneLeft), L::le(px, zoneRight)),
+                          L::bitAnd(L::ge(py, zoneTop), L::le(py, zoneBottom)));
+        won = L::bitAnd(won, act);
+        act = L::andNot(won, act);
+
+        // Paredes, techo y piso (GameEngine::handleWallCollisions)
+        V hitLeft = L::bitAnd(L::le(L::sub(px, vradius), zero), act);
+        V hitRight = L::andNot(hitLeft, L::bitAnd(L::ge(L::add(px, vradius), wallRight), act));
+        V hitX = L::bitOr(hitLeft, hitRight);
+        pvx = L::select(hitX, L::neg(pvx), pvx);
+        px = L::select(hitLeft, vradius, px);
+        px = L::select(hitRight, rightX, px);
+
+        V hitTop = L::bitAnd(L::le(L::sub(py, vradius), zero), act);
+        pvy = L::select(hitTop, L::neg(pvy), pvy);
+        py = L::select(hitTop, vradius, py);
+
+        V hitFloor = L::bitAnd(L::ge(L::add(py, vradius), floor), act);
+        pvy = L::select(hitFloor, L::mul(L::neg(pvy), floorDamping), pvy);
+        py = L::select(hitFloor, floorRest, py);
+
+        L::store(&x[i], px);
+        L::store(&y[i], py);
+        L::store(&vx[i], pvx);
+        L::store(&vy[i], pvy);
+
+        // Los eventos (raros) se resuelven carril por carril
+        int outBits = L::bits(out);
+        int wonBits = L::bits(won);
+        int bounceBits = L::bits(L::bitOr(hitX, L::bitOr(hitTop, hitFloor)));
+
+        if (outBits | wonBits | bounceBits) {
+            for (int lane = 0; lane < L::width; ++lane) {
+                int bit = 1 << lane;
+                if (wonBits & bit) winner[i + lane] = shooter;
+                if ((outBits | wonBits) & bit) deactivate(i + lane);
+                if (bounceBits & bit) registerBounce(i + lane);
+            }
+            act = L::loadMask(&active[i]);
+        }
+
+        // Circulo contra rectangulo para cada bloque enemigo; el primer
+        // bloque vivo que toca cada carril resuelve el choque
+        int pending = L::bits(act);
+        for (int b = 0; b < aliveTargets && pending; ++b) {
+            V closestX = L::max(L::set(blockLeft[b]), L::min(px, L::set(blockRight[b])));
+            V closestY = L::max(L::set(blockTop[b]), L::min(py, L::set(blockBottom[b])));
+            V dx = L::sub(px, closestX);
+            V dy = L::sub(py, closestY);
+            V dist = L::sqrt(L::add(L::mul(dx, dx), L::mul(dy, dy)));
+
+            int touching = L::bits(L::lt(dist, vradius)) & pending;
+            if (touching == 0) continue;
+
+            for (int lane = 0; lane < L::width; ++lane) {
+                if ((touching & (1 << lane)) && resolveHit(i + lane, b)) {
+                    pending &= ~(1 << lane);
+                }
+            }
+        }
+
+        V late = L::bitAnd(L::gt(stepY, lateY), L::loadMask(&active[i]));
+        if (int lateBits = L::bits(late)) {
+            for (int lane = 0; lane < L::width; ++lane) {
+                if (lateBits & (1 << lane)) deactivate(i + lane);
+            }
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        stepScalar(i, dt);
+    }
+
+    return liveCount > 0;
+}
+
+int ProjectileBatch::run(double dt, int maxSteps)
+{
+    int executed = 0;
+    while (executed < maxSteps && step(dt)) {
+        executed++;
+    }
+    return executed;
+}
+
+ShotResult ProjectileBatch::result(int i) const
+{
+    ShotResult r;
+    r.winner = winner[i];
+    r.bounces = bounce[i];
+    r.steps = active[i] ? stepIndex : steps[i];
+
+    // Dano real golpe a golpe, en el mismo orden en que lo acumula el motor
+    const int* blocks = &hitBlock[i * maxHits];
+    const double* damages = &hitDamage[i * maxHits];
+
+    for (int h = 0; h < hitCount[i]; ++h) {
+        if (r.firstHitIndex < 0) {
+            r.firstHitIndex = blockIndex[blocks[h]];
+        }
+
+        double before = blockResistance[blocks[h]];
+        for (int k = 0; k < h; ++k) {
+            if (blocks[k] == blocks[h]) {
+                before -= damages[k];
+                if (before < 0) before = 0;
+            }
+        }
+
+        double after = before - damages[h];
+        if (after < 0) after = 0;
+        r.damage += before - after;
+    }
+    return r;
+}
@@ -0,0 +1,87 @@
+#ifndef PROJECTILEBATCH_H
+#define PROJECTILEBATCH_H
+
+#include "gameengine.h"
+#include "shotrunner.h"
+#include <QRectF>
+#include <cstdint>
+#include <vector>
+
+// Lote de proyectiles independientes guardado como estructura de arreglos
+// (x[], y[], vx[], vy[], rebotes[], mascara de activos) para simular
+// muchos disparos a la vez con instrucciones SIMD (AVX2 si el motor se
+// compila con CONFIG+=engine_avx2, SSE2 en x86-64 y escalar en el resto).
+//
+// Cada proyectil reproduce un disparo de GameEngine::update contra el
+// escenario del prototipo: misma integracion, rebotes en paredes y piso,
+// choques con la infraestructura enemiga y zona del rival. Los bloques no
+// se comparten entre proyectiles: cada uno ve el dano que el mismo les hizo.
+class ProjectileBatch
+{
+public:
+    // Toma el escenario y el jugador actual del prototipo
+    explicit ProjectileBatch(const GameEngine& prototype);
+
+    void reserve(int count);
+    void clear();
+
+    // Agrega un disparo desde el cañon del jugador actual; devuelve su indice
+    int add(double angle, double speed);
+
+    int size() const { return count; }
+    int activeCount() const { return liveCount; }
+
+    // Avanza todos los proyectiles activos un paso; false si ya no queda ninguno
+    bool step(double dt);
+
+    // Avanza hasta que todos se detienen; devuelve los pasos ejecutados
+    int run(double dt, int maxSteps = 100000);
+
+    double getX(int i) const { return x[i]; }
+    double getY(int i) const { return y[i]; }
+    double getVelocityX(int i) const { return vx[i]; }
+    double getVelocityY(int i) const { return vy[i]; }
+    int getBounceCount(int i) const { return bounce[i]; }
+    bool isActive(int i) const { return active[i] != 0; }
+
+    // Resultado del disparo i con el mismo formato que runShot()
+    ShotResult result(int i) const;
+
+private:
+    static constexpr int maxHits = 3;  // Un proyectil se detiene al tercer rebote
+
+    // Escenario (copiado del prototipo)
+    double boxWidth, boxHeight, floorY;
+    double radius;
+    double restitution, damageFactor, mass;
+    QPointF cannon;
+    QRectF rivalZone;
+    int shooter;
+    int aliveTargets;
+
+    // Bloques enemigos vivos en formato SoA
+    std::vector<double> blockLeft, blockTop, blockRight, blockBottom, blockResistance;
+    std::vector<int> blockIndex;  // Indice original en la infraestructura del rival
+
+    // Estado de los proyectiles
+    int count;
+    int liveCount;
+    int stepIndex;
+    std::vector<double> x, y, vx, vy;
+    std::vector<std::uint64_t> active;  // Todo unos si esta activo (mascara de carril)
+    std::vector<std::int32_t> bounce;
+    std::vector<std::int32_t> steps;
+    std::vector<std::int32_t> winner;
+    std::vector<std::int32_t> hitCount;
+    std::vector<std::int32_t> hitBlock;   // maxHits entradas por proyectil
+    std::vector<double> hitDamage;        // maxHits entradas por proyectil
+
+    void deactivate(int i);
+    void registerBounce(int i);
+    bool resolveHit(int i, int block);
+    double remainingResistance(int i, int block) const;
+    void stepScalar(int i, double dt);
+    void stepInfrastructure(int i);
+};
+
+#endif // PROJECTILEBATCH_H
@@ -0,0 +1,299 @@
+#include "replay.h"
+#include <QDataStream>
+#include <QFile>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+static const char replayMagic[4] = {'L', '5', 'R', 'P'};
+
+// Limite de cordura para no reservar memoria con un archivo corrupto
+static const quint32 maxReplayItems = 1u << 24;
+
+Replay::Replay()
+    : boxWidth(800), boxHeight(600), dt(0.016), continuousCollision(false),
+    eventDriven(false), startPlayer(1)
+{
+    copyGeometry(GameEngine(boxWidth, boxHeight));
+}
+
+void Replay::copyGeometry(const GameEngine& engine)
+{
+    floorY = engine.getFloorY();
+    for (int player = 1; player <= 2; ++player) {
+        cannonPositions[player - 1] = engine.getCannonPosition(player);
+        rivalZones[player - 1] = engine.getRivalZone(player);
+    }
+}
+
+void Replay::begin(const GameEngine& engine, double stepDt)
+{
+    boxWidth = engine.getBoxWidth();
+    boxHeight = engine.getBoxHeight();
+    copyGeometry(engine);
+    dt = stepDt;
+    continuousCollision = engine.isContinuousCollision();
+    eventDriven = engine.isEventDriven();
+    startPlayer = engine.getCurrentPlayer();
+    player1Layout = engine.getPlayer1Infrastructure();
+    player2Layout = engine.getPlayer2Infrastructure();
+    shots.clear();
+}
+
+void Replay::addShot(int player, double angle, double speed, int count, double spread)
+{
+    shots.append({player, angle, speed, count, spread});
+}
+
+void Replay::prepareEngine(GameEngine& engine) const
+{
+    engine.setFloorY(floorY);
+    for (int player = 1; player <= 2; ++player) {
+        engine.setCannonPosition(player, cannonPositions[player - 1]);
+        engine.setRivalZone(player, rivalZones[player - 1]);
+    }
+    for (const Infrastructure& block : player1Layout) {
+        engine.addInfrastructure(1, block);
+    }
+    for (const Infrastructure& block : player2Layout) {
+        engine.addInfrastructure(2, block);
+    }
+    engine.setContinuousCollision(continuousCollision);
+    engine.setEventDriven(eventDriven);
+    if (engine.getCurrentPlayer() != startPlayer) {
+        engine.switchTurn();
+    }
+    engine.buildSpatialIndex();
+}
+
+static bool isSliderValue(double value)
+{
+    return value >= 0 && value <= 65535 && value == std::floor(value);
+}
+
+QByteArray Replay::save() const
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setByteOrder(QDataStream::LittleEndian);
+    out.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    out.writeRawData(replayMagic, 4);
+    out << formatVersion;
+    out << quint8((continuousCollision ? 1 : 0) | (eventDriven ? 2 : 0));
+    out << quint8(startPlayer);
+    out << dt << boxWidth << boxHeight << floorY;
+    for (int i = 0; i < 2; ++i) {
+        out << cannonPositions[i].x() << cannonPositions[i].y();
+    }
+    for (int i = 0; i < 2; ++i) {
+        const QRectF& zone = rivalZones[i];
+        out << zone.x() << zone.y() << zone.width() << zone.height();
+    }
+
+    for (const QVector<Infrastructure>* layout : {&player1Layout, &player2Layout}) {
+        out << quint32(layout->size());
+        for (const Infrastructure& block : *layout) {
+            QRectF rect = block.getRect();
+            out << rect.x() << rect.y() << rect.width() << rect.height() << block.getResistance();
+        }
+    }
+
+    out << quint32(shots.size());
+    for (const ReplayShot& shot : shots) {
+        bool compact = isSliderValue(shot.angle) && isSliderValue(shot.speed);
+        bool volley = shot.count > 1;
+        out << quint8((shot.player == 2 ? 1 : 0) | (compact ? 2 : 0) | (volley ? 4 : 0));
+        if (compact) {
+            out << quint16(shot.angle) << quint16(shot.speed);
+        } else {
+            out << shot.angle << shot.speed;
+        }
+        if (volley) {
+            out << quint8(shot.count) << shot.spread;
+        }
+    }
+
+    return data;
+}
+
+bool Replay::load(const QByteArray& data)
+{
+    QDataStream in(data);
+    in.setByteOrder(QDataStream::LittleEndian);
+    in.setFloatingPointPrecision(QDataStream::DoublePrecision);
+
+    char magic[4];
+    if (in.readRawData(magic, 4) != 4 || std::memcmp(magic, replayMagic, 4) != 0) {
+        return false;
+    }
+
+    quint16 version;
+    quint8 flags, player;
+    in >> version;
+    if (in.status() != QDataStream::Ok || version < 1 || version > formatVersion) {
+        return false;
+    }
+
+    Replay loaded;
+    in >> flags >> player >> loaded.dt >> loaded.boxWidth >> loaded.boxHeight;
+    loaded.continuousCollision = (flags & 1) != 0;
+    loaded.eventDriven = (flags & 2) != 0;
+    loaded.startPlayer = (player == 2) ? 2 : 1;
+
+    // Antes de la version 3 el nivel era siempre el tablero original
+    loaded.copyGeometry(GameEngine(loaded.boxWidth, loaded.boxHeight));
+    if (version >= 3) {
+        double values[13];
+        for (double& value : values) {
+            in >> value;
+        }
+        loaded.floorY = values[0];
+        loaded.cannonPositions[0] = QPointF(values[1], values[2]);
+        loaded.cannonPositions[1] = QPointF(values[3], values[4]);
+        loaded.rivalZones[0] = QRectF(values[5], values[6], values[7], values[8]);
+        loaded.rivalZones[1] = QRectF(values[9], values[10], values[11], values[12]);
+    }
+
+    for (QVector<Infrastructure>* layout : {&loaded.player1Layout, &loaded.player2Layout}) {
+        quint32 count;
+        in >> count;
+        if (in.status() != QDataStream::Ok || count > maxReplayItems) return false;
+
+        for (quint32 i = 0; i < count; ++i) {
+            double x, y, w, h, resistance;
+            in >> x >> y >> w >> h >> resistance;
+            if (in.status() != QDataStream::Ok) return false;
+            layout->append(Infrastructure(x, y, w, h, resistance));
+        }
+    }
+
+    quint32 shotCount;
+    in >> shotCount;
+    if (in.status() != QDataStream::Ok || shotCount > maxReplayItems) return false;
+
+    for (quint32 i = 0; i < shotCount; ++i) {
+        quint8 tag;
+        in >> tag;
+
+        ReplayShot shot;
+        shot.player = (tag & 1) ? 2 : 1;
+        if (tag & 2) {
+            quint16 angle, speed;
+            in >> angle >> speed;
+            shot.angle = angle;
+            shot.speed = speed;
+        } else {
+            in >> shot.angle >> shot.speed;
+        }
+
+        shot.count = 1;
+        shot.spread = 0.0;
+        if (tag & 4) {
+            quint8 count;
+            in >> count >> shot.spread;
+            shot.count = count;
+        }
+
+        if (in.status() != QDataStream::Ok) return false;
+        loaded.shots.append(shot);
+    }
+
+    if (!(loaded.dt > 0)) return false;
+
+    *this = loaded;
+    return true;
+}
+
+bool Replay::saveToFile(const QString& path) const
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    QByteArray data = save();
+    return file.write(data) == data.size();
+}
+
+bool Replay::loadFromFile(const QString& path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    return load(file.readAll());
+}
+
+ReplayPlayer::ReplayPlayer(const Replay& replay)
+    : replay(replay),
+    engine(replay.getBoxWidth(), replay.getBoxHeight()),
+    turn(0)
+{
+    replay.prepareEngine(engine);
+    keyframes.reserve(replay.getShotCount() + 1);
+    saveKeyframe();
+}
+
+void ReplayPlayer::saveKeyframe()
+{
+    GameState state;
+    engine.snapshot(state, resistance);
+    keyframes.push_back(state);
+    keyframeResistance.insert(keyframeResistance.end(), resistance.begin(), resistance.end());
+}
+
+bool ReplayPlayer::stepTurn()
+{
+    if (turn >= replay.getShotCount() || engine.isGameOver()) {
+        return false;
+    }
+
+    const ReplayShot& shot = replay.getShot(turn);
+    if (engine.getCurrentPlayer() != shot.player) {
+        engine.switchTurn();
+    }
+
+    // Mismos pasos que la interfaz: update(dt) hasta que el proyectil se detiene
+    engine.launchVolley(shot.player, shot.angle, shot.speed, shot.count, shot.spread);
+    while (engine.update(replay.getDt())) {
+    }
+
+    const ShotStats& stats = engine.getShotStats();
+    lastResult = ShotResult();
+    lastResult.winner = engine.isGameOver() ? engine.getWinner() : 0;
+    lastResult.firstHitIndex = stats.firstHitIndex;
+    lastResult.damage = stats.damageDealt;
+    lastResult.bounces = engine.getActiveProjectile() ? engine.getActiveProjectile()->getBounceCount() : 0;
+    lastResult.steps = stats.steps;
+
+    // Igual que la interfaz: si nadie gano, pasa el turno
+    if (!engine.isGameOver()) {
+        engine.switchTurn();
+    }
+    turn++;
+
+    if (turn == static_cast<int>(keyframes.size()) &&
+        keyframeResistance.size() * sizeof(double) < maxKeyframeBytes) {
+        saveKeyframe();
+    }
+    return true;
+}
+
+void ReplayPlayer::seek(int target)
+{
+    target = std::max(0, std::min(target, replay.getShotCount()));
+
+    // Volver a la instantanea mas cercana anterior al turno pedido, salvo
+    // que el turno actual este mas cerca
+    const int known = std::min(target, static_cast<int>(keyframes.size()) - 1);
+    if (target < turn || known > turn) {
+        const size_t blocks = keyframeResistance.size() / keyframes.size();
+        engine.restore(keyframes[known], keyframeResistance.data() + known * blocks);
+        turn = known;
+    }
+
+    lastResult = ShotResult();
+    while (turn < target && stepTurn()) {
+    }
+}
@@ -0,0 +1,127 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "gameengine.h"
+#include "shotrunner.h"
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+#include <vector>
+
+// Disparo grabado: lo unico que decide cada jugador en su turno
+struct ReplayShot
+{
+    int player;
+    double angle;
+    double speed;
+    int count;      // Proyectiles de la andanada (1 = disparo normal)
+    double spread;  // Abanico de la andanada en grados
+};
+
+// Repeticion de una partida: escenario inicial, modo de colision, paso de
+// simulacion y la lista de disparos. Como el motor es determinista, volver
+// a simular los disparos reproduce la partida exacta.
+//
+// Formato binario (little endian), version 3:
+//   "L5RP", quint16 version, quint8 banderas (bit 0 continua, bit 1 por
+//   eventos), quint8 jugador inicial, double dt, double ancho, double alto,
+//   double suelo, x, y de cada cañon y x, y, w, h de la zona de cada rival
+//   (double), por jugador quint32 bloques y x, y, w, h, resistencia (double) de cada
+//   uno, quint32 disparos y cada disparo. Un disparo empieza con un byte:
+//   bit 0 jugador (0 = 1, 1 = 2) y bit 1 valores enteros; si son enteros
+//   (los sliders) siguen angulo y velocidad como quint16 (5 bytes en total),
+//   si no como double (17 bytes). Con el bit 2 es una andanada y ademas
+//   siguen quint8 proyectiles y double abanico. Las versiones 1 y 2 no
+//   tenian la geometria del nivel (se usa la del tablero original) y la 1
+//   tampoco andanadas; se siguen pudiendo leer.
+class Replay
+{
+public:
+    static constexpr quint16 formatVersion = 3;
+
+    Replay();
+
+    // Graba el estado actual del motor como inicio de la partida y borra
+    // los disparos; dt es el paso con el que se avanza la simulacion
+    void begin(const GameEngine& engine, double dt);
+    void addShot(int player, double angle, double speed, int count = 1, double spread = 0.0);
+
+    int getShotCount() const { return shots.size(); }
+    const ReplayShot& getShot(int index) const { return shots[index]; }
+    double getDt() const { return dt; }
+
+    // Deja un motor recien creado (GameEngine(ancho, alto) sin bloques) en
+    // el estado inicial de la partida
+    void prepareEngine(GameEngine& engine) const;
+    double getBoxWidth() const { return boxWidth; }
+    double getBoxHeight() const { return boxHeight; }
+
+    QByteArray save() const;
+    bool load(const QByteArray& data);  // false si el formato no es valido
+
+    bool saveToFile(const QString& path) const;
+    bool loadFromFile(const QString& path);
+
+private:
+    double boxWidth, boxHeight;
+    double floorY;
+    QPointF cannonPositions[2];
+    QRectF rivalZones[2];
+    double dt;
+    bool continuousCollision;
+    bool eventDriven;
+    int startPlayer;
+    QVector<Infrastructure> player1Layout;
+    QVector<Infrastructure> player2Layout;
+    QVector<ReplayShot> shots;
+
+    void copyGeometry(const GameEngine& engine);
+};
+
+// Reproduce una repeticion turno a turno tan rapido como permita la CPU.
+// Guarda una instantanea al final de cada turno jugado, asi que volver a
+// un turno ya visto es inmediato y avanzar solo simula los turnos nuevos.
+// Las instantaneas dejan de guardarse cuando sus resistencias pasan de
+// maxKeyframeBytes (en niveles muy grandes); desde ahi se vuelve a simular
+// desde la ultima. La repeticion debe seguir existiendo mientras se use el
+// reproductor.
+class ReplayPlayer
+{
+public:
+    static constexpr size_t maxKeyframeBytes = 16 * 1024 * 1024;
+
+    explicit ReplayPlayer(const Replay& replay);
+
+    // Juega el siguiente disparo completo; false si no quedan o el juego termino
+    bool stepTurn();
+
+    // Deja el motor al inicio del turno indicado (0 = antes del primer disparo)
+    void seek(int turn);
+
+    int getTurn() const { return turn; }
+    const GameEngine& getEngine() const { return engine; }
+
+    // Receptor de los eventos del motor de la repeticion (ver
+    // GameEngine::setEventCallback); se conserva al volver atras con seek()
+    void setEventCallback(GameEventCallback callback, void* context = nullptr)
+    {
+        engine.setEventCallback(callback, context);
+    }
+    const ShotResult& getLastResult() const { return lastResult; }
+
+private:
+    const Replay& replay;
+    GameEngine engine;
+    int turn;
+    ShotResult lastResult;
+
+    // keyframes[t] = estado al inicio del turno t; sus resistencias van en
+    // keyframeResistance a partir de t * bloques del escenario
+    std::vector<GameState> keyframes;
+    std::vector<double> keyframeResistance;
+    std::vector<double> resistance;  // Para snapshot()
+
+    void saveKeyframe();
+};
+
+#endif // REPLAY_H
@@ -0,0 +1,64 @@
+#ifndef SCALAR_H
+#define SCALAR_H
+
+#include <QPointF>
+#include <QRectF>
+#include <algorithm>
+#include <cmath>
+
+// Tipo numerico de la fisica por pasos del motor (Projectile,
+// Infrastructure y GameEngine::update). Por defecto es double; compilando
+// con "qmake CONFIG+=engine_fixed" (ENGINE_FIXED_POINT) es el punto fijo
+// Q32.32 de fixedpoint.h, con trigonometria por tabla y raiz entera, y las
+// trayectorias salen iguales bit a bit en cualquier compilacion. Vec2 y
+// Rect son QPointF y QRectF o sus equivalentes de punto fijo.
+//
+// La interfaz publica del motor sigue en double, QPointF y QRectF; las
+// funciones de abajo convierten en los bordes y con double no hacen nada,
+// asi que esa compilacion da los mismos resultados que antes. El modo por
+// eventos (ballistics.h) y ProjectileBatch trabajan siempre en double.
+#ifdef ENGINE_FIXED_POINT
+
+#include "fixedpoint.h"
+
+typedef Fixed Scalar;
+typedef FixedVector Vec2;
+typedef FixedRect Rect;
+
+inline Scalar toScalar(double value) { return Fixed(value); }
+inline Vec2 toVec2(const QPointF& p) { return FixedVector(Fixed(p.x()), Fixed(p.y())); }
+inline Rect toRect(const QRectF& r)
+{
+    return FixedRect(Fixed(r.x()), Fixed(r.y()), Fixed(r.width()), Fixed(r.height()));
+}
+
+inline Scalar scalarAbs(Scalar value) { return fixedAbs(value); }
+inline Scalar scalarSqrt(Scalar value) { return fixedSqrt(value); }
+inline Scalar scalarCosDegrees(double degrees) { return fixedCosDegrees(Fixed(degrees)); }
+inline Scalar scalarSinDegrees(double degrees) { return fixedSinDegrees(Fixed(degrees)); }
+
+// Umbral para comparar con casi cero: en punto fijo no baja de un paso
+inline Scalar scalarEpsilon(double value) { return std::max(Fixed(value), Fixed::fromRaw(1)); }
+
+#else
+
+typedef double Scalar;
+typedef QPointF Vec2;
+typedef QRectF Rect;
+
+inline double toScalar(double value) { return value; }
+inline const QPointF& toVec2(const QPointF& p) { return p; }
+inline const QRectF& toRect(const QRectF& r) { return r; }
+inline double toDouble(double value) { return value; }
+inline const QPointF& toQPointF(const QPointF& p) { return p; }
+inline const QRectF& toQRectF(const QRectF& r) { return r; }
+
+inline double scalarAbs(double value) { return std::abs(value); }
+inline double scalarSqrt(double value) { return std::sqrt(value); }
+inline double scalarCosDegrees(double degrees) { return std::cos(degrees * M_PI / 180.0); }
+inline double scalarSinDegrees(double degrees) { return std::sin(degrees * M_PI / 180.0); }
+inline double scalarEpsilon(double value) { return value; }
+
+#endif
+
+#endif // SCALAR_H
@@ -0,0 +1,225 @@
+#include "shotplanner.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+typedef std::chrono::steady_clock PlannerClock;
+
+double scoreShot(const ShotResult& result, int player)
+{
+    if (result.winner == player) {
+        // Entre disparos ganadores se prefiere el que llega antes
+        return 1e9 - result.steps;
+    }
+    return result.damage;
+}
+
+namespace {
+
+// Copia del escenario con el indice espacial ya construido, para que las
+// copias que se hacen de ella no lo vuelvan a construir
+GameEngine indexedCopy(const GameEngine& state)
+{
+    GameEngine copy(state);
+    copy.buildSpatialIndex();
+    return copy;
+}
+
+// Motor de trabajo de un hilo: se reinicia desde la instantanea antes de
+// cada disparo
+class Evaluator
+{
+public:
+    Evaluator(const GameEngine& state, double dt)
+        : base(indexedCopy(state)), engine(base), dt(dt), player(state.getCurrentPlayer()), evaluated(0)
+    {
+        base.snapshot(start, startResistance);
+    }
+
+    double evaluate(double angle, double speed, ShotResult& result)
+    {
+        if (!engine.restore(start, startResistance.data())) {
+            engine = base;
+        }
+        result = runShot(engine, angle, speed, dt);
+        evaluated++;
+        return scoreShot(result, player);
+    }
+
+    int getEvaluated() const { return evaluated; }
+
+private:
+    GameEngine base;
+    GameEngine engine;
+    GameState start;
+    std::vector<double> startResistance;
+    double dt;
+    int player;
+    int evaluated;
+};
+
+struct Candidate
+{
+    double angle;
+    double speed;
+    double score;
+    ShotResult result;
+};
+
+bool better(const Candidate& a, const Candidate& b)
+{
+    // Desempate fijo para que el orden no dependa de los hilos
+    if (a.score != b.score) return a.score > b.score;
+    if (a.angle != b.angle) return a.angle < b.angle;
+    return a.speed < b.speed;
+}
+
+} // namespace
+
+PlannedShot planShot(const GameEngine& state, const PlannerSettings& settings,
+                     const std::atomic<bool>* cancel)
+{
+    const PlannerClock::time_point deadline = PlannerClock::now() +
+        std::chrono::microseconds(static_cast<long long>(settings.timeBudgetMs * 1000.0));
+
+    int threadCount = settings.threadCount;
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threadCount = std::max(1, threadCount);
+
+    const int angleCount = std::max(1, static_cast<int>(std::floor(
+        (settings.angleMax - settings.angleMin) / settings.coarseAngleStep + 1e-9)) + 1);
+    const int speedCount = std::max(1, static_cast<int>(std::floor(
+        (settings.speedMax - settings.speedMin) / settings.coarseSpeedStep + 1e-9)) + 1);
+    const int cells = angleCount * speedCount;
+
+    // Se detiene al acabar el tiempo, al cancelar o al encontrar un disparo ganador
+    std::atomic<bool> stop(false);
+    auto shouldStop = [&]() {
+        if (stop.load(std::memory_order_relaxed)) return true;
+        if ((cancel && cancel->load(std::memory_order_relaxed)) || PlannerClock::now() >= deadline) {
+            stop.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    };
+    const int player = state.getCurrentPlayer();
+
+    std::vector<Candidate> coarse(cells, Candidate{0, 0, -1, ShotResult()});
+    std::atomic<int> nextCell(0);
+    std::atomic<int> nextSeed(0);
+    std::vector<Candidate> refined(threadCount, Candidate{0, 0, -1, ShotResult()});
+    std::vector<int> evaluated(threadCount, 0);
+    std::vector<Candidate> seeds;
+
+    // Fase 1: rejilla gruesa repartida celda a celda
+    auto coarseWorker = [&](Evaluator& evaluator) {
+        for (int c = nextCell.fetch_add(1); c < cells && !shouldStop(); c = nextCell.fetch_add(1)) {
+            Candidate& candidate = coarse[c];
+            candidate.angle = settings.angleMin + (c / speedCount) * settings.coarseAngleStep;
+            candidate.speed = settings.speedMin + (c % speedCount) * settings.coarseSpeedStep;
+            candidate.score = evaluator.evaluate(candidate.angle, candidate.speed, candidate.result);
+            if (candidate.result.winner == player) {
+                stop.store(true, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    // Fase 2: busqueda por patrones alrededor de cada semilla; el paso se
+    // reduce a la mitad cuando ningun vecino mejora
+    auto refineWorker = [&](Evaluator& evaluator, Candidate& best) {
+        for (int k = nextSeed.fetch_add(1); k < static_cast<int>(seeds.size()) && !shouldStop();
+             k = nextSeed.fetch_add(1)) {
+            Candidate current = seeds[k];
+            double angleStep = settings.coarseAngleStep * 0.5;
+            double speedStep = settings.coarseSpeedStep * 0.5;
+
+            while ((angleStep > 0.05 || speedStep > 0.1) && !shouldStop()) {
+                const double moves[4][2] = {{angleStep, 0}, {-angleStep, 0}, {0, speedStep}, {0, -speedStep}};
+                bool improved = false;
+
+                for (const auto& move : moves) {
+                    Candidate next;
+                    next.angle = std::max(settings.angleMin, std::min(settings.angleMax, current.angle + move[0]));
+                    next.speed = std::max(settings.speedMin, std::min(settings.speedMax, current.speed + move[1]));
+                    next.score = evaluator.evaluate(next.angle, next.speed, next.result);
+                    if (better(next, current)) {
+                        current = next;
+                        improved = true;
+                    }
+                    if (current.result.winner == player) {
+                        stop.store(true, std::memory_order_relaxed);
+                    }
+                    if (shouldStop()) break;
+                }
+
+                if (!improved) {
+                    angleStep *= 0.5;
+                    speedStep *= 0.5;
+                }
+            }
+
+            if (better(current, best)) best = current;
+        }
+    };
+
+    auto worker = [&](int index) {
+        Evaluator evaluator(state, settings.dt);
+        coarseWorker(evaluator);
+        evaluated[index] = evaluator.getEvaluated();
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (int t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Los mejores de la rejilla (dos por hilo, al menos 8) son las semillas
+    // del refinamiento
+    for (const Candidate& candidate : coarse) {
+        if (candidate.score >= 0) seeds.push_back(candidate);
+    }
+    std::sort(seeds.begin(), seeds.end(), better);
+
+    Candidate best = seeds.empty() ? Candidate{45.0, 150.0, -1, ShotResult()} : seeds.front();
+
+    if (!shouldStop() && !seeds.empty()) {
+        seeds.resize(std::min<size_t>(seeds.size(), std::max(2 * threadCount, 8)));
+        threads.clear();
+
+        auto refineThread = [&](int index) {
+            Evaluator evaluator(state, settings.dt);
+            refineWorker(evaluator, refined[index]);
+            evaluated[index] += evaluator.getEvaluated();
+        };
+        for (int t = 1; t < threadCount; ++t) {
+            threads.emplace_back(refineThread, t);
+        }
+        refineThread(0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+
+        for (const Candidate& candidate : refined) {
+            if (candidate.score >= 0 && better(candidate, best)) best = candidate;
+        }
+    }
+
+    PlannedShot shot;
+    shot.angle = best.angle;
+    shot.speed = best.speed;
+    shot.score = best.score;
+    shot.result = best.result;
+    for (int count : evaluated) {
+        shot.evaluated += count;
+    }
+    return shot;
+}
@@ -0,0 +1,49 @@
+#ifndef SHOTPLANNER_H
+#define SHOTPLANNER_H
+
+#include "gameengine.h"
+#include "shotrunner.h"
+#include <atomic>
+
+// Parametros de la busqueda del mejor disparo
+struct PlannerSettings
+{
+    double timeBudgetMs = 50.0;  // Tiempo maximo de busqueda
+    int threadCount = 0;         // 0 = todos los nucleos
+    double dt = 0.016;           // Paso con el que se simula cada candidato
+
+    // Rango de los sliders y paso de la rejilla gruesa inicial
+    double angleMin = 0.0;
+    double angleMax = 90.0;
+    double speedMin = 50.0;
+    double speedMax = 300.0;
+    double coarseAngleStep = 5.0;
+    double coarseSpeedStep = 10.0;
+};
+
+// Disparo elegido y lo que se espera que haga
+struct PlannedShot
+{
+    double angle = 45.0;
+    double speed = 150.0;
+    double score = -1.0;     // Mayor es mejor; ver scoreShot()
+    ShotResult result;
+    int evaluated = 0;       // Disparos simulados durante la busqueda
+};
+
+// Puntaje de un disparo para el jugador que lo hace: alcanzar al rival (o
+// destruir toda su infraestructura) gana siempre; si no, cuenta el daño
+double scoreShot(const ShotResult& result, int player);
+
+// Busca el disparo del jugador actual de state que mas puntaje obtiene:
+// primero una rejilla gruesa de angulos y velocidades y despues un
+// refinamiento local (busqueda por patrones) alrededor de los mejores
+// candidatos. Cada candidato se simula en una copia del motor restaurada
+// desde una instantanea, con el mismo modo de colision que state. Usa
+// threadCount hilos y termina al agotar el tiempo, al encontrar un disparo
+// ganador o si cancel se pone en true; siempre devuelve el mejor disparo
+// encontrado hasta ese momento. state no se modifica.
+PlannedShot planShot(const GameEngine& state, const PlannerSettings& settings = PlannerSettings(),
+                     const std::atomic<bool>* cancel = nullptr);
+
+#endif // SHOTPLANNER_H
@@ -0,0 +1,35 @@
+#include "shotrunner.h"
+
+ShotResult runShot(GameEngine& engine, double angle, double speed, double dt, int maxSteps)
+{
+    ShotResult result;
+
+    if (engine.isGameOver()) {
+        result.winner = engine.getWinner();
+        return result;
+    }
+
+    engine.launchProjectile(engine.getCurrentPlayer(), angle, speed);
+
+    // En el modo por eventos cada paso salta directamente al siguiente choque
+    int steps = 0;
+    if (engine.isEventDriven()) {
+        while (steps < maxSteps && engine.advanceToNextEvent()) {
+            steps++;
+        }
+    } else {
+        while (steps < maxSteps && engine.update(dt)) {
+            steps++;
+        }
+    }
+
+    const ShotStats& stats = engine.getShotStats();
+    const Projectile* proj = engine.getActiveProjectile();
+
+    result.winner = engine.isGameOver() ? engine.getWinner() : 0;
+    result.firstHitIndex = stats.firstHitIndex;
+    result.damage = stats.damageDealt;
+    result.bounces = proj ? proj->getBounceCount() : 0;
+    result.steps = stats.steps;
+    return result;
+}
@@ -0,0 +1,23 @@
+#ifndef SHOTRUNNER_H
+#define SHOTRUNNER_H
+
+#include "gameengine.h"
+
+// Resultado de simular un disparo completo sin interfaz grafica
+struct ShotResult
+{
+    int winner = 0;          // Jugador que gano con este disparo, 0 si ninguno
+    int firstHitIndex = -1;  // Primer bloque enemigo golpeado, -1 si ninguno
+    double damage = 0.0;     // Resistencia total quitada al rival
+    int bounces = 0;         // Rebotes del proyectil (paredes e infraestructura)
+    int steps = 0;           // Pasos (o eventos) de simulacion hasta que el proyectil se detuvo
+};
+
+// Lanza un disparo del jugador actual y avanza el motor con pasos fijos
+// hasta que el proyectil se detiene, sin esperar a ningun temporizador.
+// Si el motor esta en modo por eventos se salta de evento en evento y dt no
+// se usa. maxSteps evita bucles infinitos si el proyectil nunca se desactiva.
+ShotResult runShot(GameEngine& engine, double angle, double speed,
+                   double dt = 0.016, int maxSteps = 100000);
+
+#endif // SHOTRUNNER_H
@@ -0,0 +1,78 @@
+#include "shotsweep.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+static int stepCount(double min, double max, double step)
+{
+    if (step <= 0 || max < min) return (max >= min) ? 1 : 0;
+    // Tolerancia para que max entre en la rejilla pese al redondeo
+    return static_cast<int>(std::floor((max - min) / step + 1e-9)) + 1;
+}
+
+int SweepGrid::angleCount() const
+{
+    return stepCount(angleMin, angleMax, angleStep);
+}
+
+int SweepGrid::speedCount() const
+{
+    return stepCount(speedMin, speedMax, speedStep);
+}
+
+QVector<ShotResult> sweepShots(const GameEngine& prototype, const SweepGrid& grid,
+                               double dt, int threadCount)
+{
+    const int rows = grid.angleCount();
+    const int columns = grid.speedCount();
+
+    QVector<ShotResult> results(rows * columns);
+    if (results.isEmpty()) return results;
+
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threadCount = std::max(1, std::min(threadCount, rows));
+
+    // Las filas se reparten dinamicamente: los disparos largos (muchos
+    // rebotes) no dejan a un hilo trabajando mientras los demas esperan.
+    std::atomic<int> nextRow(0);
+    ShotResult* out = results.data();
+
+    auto worker = [&]() {
+        // Copia propia del prototipo y motor de trabajo que se reinicia
+        // desde ella en cada celda sin reservar memoria: con la instantanea
+        // solo se reescriben resistencias y proyectil.
+        GameEngine base(prototype);
+        base.buildSpatialIndex();
+        GameEngine engine(base);
+        GameState start;
+        std::vector<double> startResistance;
+        base.snapshot(start, startResistance);
+
+        for (int a = nextRow.fetch_add(1); a < rows; a = nextRow.fetch_add(1)) {
+            double angle = grid.angleAt(a);
+            for (int s = 0; s < columns; ++s) {
+                if (!engine.restore(start, startResistance.data())) {
+                    engine = base;
+                }
+                out[grid.cellIndex(a, s)] = runShot(engine, angle, grid.speedAt(s), dt);
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (int t = 1; t < threadCount; ++t) {
+        threads.emplace_back(worker);
+    }
+    worker();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    return results;
+}
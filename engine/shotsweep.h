@@ -0,0 +1,37 @@
+#ifndef SHOTSWEEP_H
+#define SHOTSWEEP_H
+
+#include "gameengine.h"
+#include "shotrunner.h"
+#include <QVector>
+
+// Rejilla de angulos y velocidades a evaluar. Por defecto cubre el rango
+// de los sliders de la interfaz (0-90 grados, velocidad 50-300).
+struct SweepGrid
+{
+    double angleMin = 0.0;
+    double angleMax = 90.0;
+    double angleStep = 1.0;
+    double speedMin = 50.0;
+    double speedMax = 300.0;
+    double speedStep = 1.0;
+
+    int angleCount() const;
+    int speedCount() const;
+    int cellCount() const { return angleCount() * speedCount(); }
+
+    double angleAt(int a) const { return angleMin + a * angleStep; }
+    double speedAt(int s) const { return speedMin + s * speedStep; }
+
+    // Las celdas se guardan por filas de angulo
+    int cellIndex(int a, int s) const { return a * speedCount() + s; }
+};
+
+// Evalua todos los disparos de la rejilla para el jugador actual del
+// prototipo, repartiendo las filas entre threadCount hilos (0 = todos los
+// nucleos). Cada hilo trabaja sobre su propia copia del motor, asi que el
+// prototipo nunca se modifica. Devuelve un ShotResult por celda.
+QVector<ShotResult> sweepShots(const GameEngine& prototype, const SweepGrid& grid,
+                               double dt = 0.016, int threadCount = 0);
+
+#endif // SHOTSWEEP_H
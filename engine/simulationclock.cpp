@@ -0,0 +1,52 @@
+#include "simulationclock.h"
+#include <algorithm>
+
+SimulationClock::SimulationClock(double fixedStep, int subSteps)
+    : fixedStep(0.016), subSteps(1), timeScale(1.0), maxStepsPerAdvance(256), accumulator(0.0)
+{
+    setFixedStep(fixedStep);
+    setSubSteps(subSteps);
+}
+
+int SimulationClock::advance(double realElapsed)
+{
+    if (realElapsed > 0) {
+        accumulator += realElapsed * timeScale;
+    }
+
+    int steps = static_cast<int>(accumulator / fixedStep);
+    if (steps > maxStepsPerAdvance) {
+        // Atraso demasiado grande (ventana arrastrada, depurador...): se
+        // simula el maximo y se conserva solo la fraccion del paso siguiente
+        steps = maxStepsPerAdvance;
+        accumulator -= fixedStep * static_cast<int>(accumulator / fixedStep);
+    } else {
+        accumulator -= steps * fixedStep;
+    }
+    accumulator = std::max(0.0, accumulator);
+
+    return steps;
+}
+
+void SimulationClock::setFixedStep(double step)
+{
+    if (step > 0) {
+        fixedStep = step;
+        accumulator = std::min(accumulator, fixedStep);
+    }
+}
+
+void SimulationClock::setSubSteps(int count)
+{
+    subSteps = std::max(1, count);
+}
+
+void SimulationClock::setTimeScale(double scale)
+{
+    timeScale = std::max(0.0, scale);
+}
+
+void SimulationClock::setMaxStepsPerAdvance(int count)
+{
+    maxStepsPerAdvance = std::max(1, count);
+}
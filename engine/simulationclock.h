@@ -0,0 +1,46 @@
+#ifndef SIMULATIONCLOCK_H
+#define SIMULATIONCLOCK_H
+
+// Reloj de paso fijo: acumula el tiempo real transcurrido (multiplicado por
+// la escala de tiempo) y lo entrega en pasos de fixedStep segundos, de modo
+// que la fisica no depende de cada cuanto dispara el temporizador de dibujo.
+// Cada paso puede dividirse en subpasos iguales para el motor. Lo que sobra
+// en el acumulador se usa para interpolar entre los dos ultimos estados.
+class SimulationClock
+{
+public:
+    explicit SimulationClock(double fixedStep = 0.016, int subSteps = 1);
+
+    // Agrega el tiempo real transcurrido y devuelve cuantos pasos fijos hay
+    // que simular. Si la simulacion se atrasa mas de maxStepsPerAdvance pasos
+    // se descarta el resto para no entrar en una espiral de pasos pendientes.
+    int advance(double realElapsed);
+
+    // Fraccion (0 a 1) del siguiente paso que ya transcurrio
+    double getAlpha() const { return accumulator / fixedStep; }
+
+    void reset() { accumulator = 0.0; }
+
+    void setFixedStep(double step);
+    double getFixedStep() const { return fixedStep; }
+
+    void setSubSteps(int count);
+    int getSubSteps() const { return subSteps; }
+    double getSubStepDt() const { return fixedStep / subSteps; }
+
+    // 1 = tiempo real, >1 camara rapida, <1 camara lenta, 0 pausa
+    void setTimeScale(double scale);
+    double getTimeScale() const { return timeScale; }
+
+    void setMaxStepsPerAdvance(int count);
+    int getMaxStepsPerAdvance() const { return maxStepsPerAdvance; }
+
+private:
+    double fixedStep;
+    int subSteps;
+    double timeScale;
+    int maxStepsPerAdvance;
+    double accumulator;
+};
+
+#endif // SIMULATIONCLOCK_H
@@ -0,0 +1,186 @@
+#include "simulationthread.h"
+#include "profiler.h"
+#include <algorithm>
+#include <chrono>
+
+typedef std::chrono::steady_clock SnapshotClock;
+
+qint64 snapshotClockNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        SnapshotClock::now().time_since_epoch()).count();
+}
+
+void captureSnapshot(const GameEngine& engine, const QPointF* previous, RenderSnapshot& snapshot)
+{
+    snapshot.projectileCount = engine.getProjectileCount();
+    for (int i = 0; i < snapshot.projectileCount; ++i) {
+        const Projectile& projectile = engine.getProjectile(i);
+        snapshot.current[i] = projectile.getPosition();
+        snapshot.previous[i] = previous ? previous[i] : snapshot.current[i];
+        snapshot.active[i] = projectile.isActive();
+    }
+    snapshot.step = engine.getShotStats().steps;
+    snapshot.currentPlayer = engine.getCurrentPlayer();
+    snapshot.gameOver = engine.isGameOver();
+    snapshot.winner = engine.getWinner();
+}
+
+SimulationThread::SimulationThread()
+    : engine(800, 600), shotNumber(0), droppedEvents(0), timeScale(1.0), abortShot(false),
+    pending(false), running(false), hasResult(false), stopping(false)
+{
+    // operator= conserva el receptor, asi que basta con registrarlo una vez
+    engine.setEventCallback(collect, this);
+    worker = std::thread(&SimulationThread::run, this);
+}
+
+SimulationThread::~SimulationThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        abortShot = true;
+    }
+    wake.notify_all();
+    worker.join();
+}
+
+quint64 SimulationThread::launch(const GameEngine& source, int player, double angle, double speed,
+                                 int count, double spread, const SimulationClock& sourceClock)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (pending || running) return 0;
+
+        // El hilo esta libre: nadie mas toca su motor ni su reloj
+        engine = source;
+        clock.setFixedStep(sourceClock.getFixedStep());
+        clock.setSubSteps(sourceClock.getSubSteps());
+        clock.setMaxStepsPerAdvance(sourceClock.getMaxStepsPerAdvance());
+        timeScale.store(sourceClock.getTimeScale(), std::memory_order_relaxed);
+        request = {player, angle, speed, count, spread};
+        abortShot = false;
+        hasResult = false;
+        pending = true;
+        shotNumber++;
+    }
+    wake.notify_all();
+    return shotNumber;
+}
+
+void SimulationThread::cancel()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    abortShot = true;
+    pending = false;
+    wake.wait(lock, [this]() { return !running; });
+    abortShot = false;
+    hasResult = false;
+
+    // El productor esta detenido: se descartan los eventos sin leer
+    events.clear();
+}
+
+bool SimulationThread::isBusy() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return pending || running;
+}
+
+bool SimulationThread::collectEngine(GameEngine& target)
+{
+    // El instantaneo final se publica justo antes de liberar el hilo, asi
+    // que esta espera es breve
+    std::unique_lock<std::mutex> lock(mutex);
+    wake.wait(lock, [this]() { return !pending && !running; });
+    if (!hasResult) return false;
+
+    target = engine;
+    hasResult = false;
+    return true;
+}
+
+void SimulationThread::collect(void* context, const GameEvent& event)
+{
+    SimulationThread* thread = static_cast<SimulationThread*>(context);
+    if (!thread->events.push(event)) {
+        thread->droppedEvents.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void SimulationThread::run()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        wake.wait(lock, [this]() { return pending || stopping; });
+        if (stopping) return;
+
+        pending = false;
+        running = true;
+        lock.unlock();
+
+        simulateShot();
+
+        lock.lock();
+        running = false;
+        hasResult = !abortShot;
+        wake.notify_all();
+    }
+}
+
+void SimulationThread::simulateShot()
+{
+    QPointF previous[GameEngine::maxProjectiles];
+
+    engine.launchVolley(request.player, request.angle, request.speed, request.count, request.spread);
+    for (int p = 0; p < engine.getProjectileCount(); ++p) {
+        previous[p] = engine.getProjectile(p).getPosition();
+    }
+    clock.reset();
+    publish(previous, false);
+
+    bool projectileActive = engine.hasActiveProjectiles();
+    qint64 last = snapshotClockNs();
+
+    while (projectileActive && !abortShot.load(std::memory_order_relaxed)) {
+        clock.setTimeScale(timeScale.load(std::memory_order_relaxed));
+
+        // Dormir hasta que toque el siguiente paso; en pausa se revisa la
+        // escala de tiempo y la cancelacion cada pocos milisegundos
+        const double scale = clock.getTimeScale();
+        double wait = (scale > 0) ? (1.0 - clock.getAlpha()) * clock.getFixedStep() / scale : 0.005;
+        std::this_thread::sleep_for(std::chrono::duration<double>(std::min(wait, 0.005)));
+
+        qint64 now = snapshotClockNs();
+        int steps = clock.advance((now - last) / 1e9);
+        last = now;
+
+        for (int i = 0; i < steps && projectileActive; ++i) {
+            {
+                PROFILE_SCOPE("SimulationThread::step", ProfileCategory::Simulation);
+                for (int p = 0; p < engine.getProjectileCount(); ++p) {
+                    previous[p] = engine.getProjectile(p).getPosition();
+                }
+                for (int s = 0; s < clock.getSubSteps() && projectileActive; ++s) {
+                    projectileActive = engine.update(clock.getSubStepDt());
+                }
+            }
+            publish(previous, false);
+        }
+    }
+
+    publish(previous, true);
+}
+
+void SimulationThread::publish(const QPointF* previous, bool finished)
+{
+    RenderSnapshot snapshot;
+    captureSnapshot(engine, previous, snapshot);
+    snapshot.shot = shotNumber;
+    snapshot.publishedNs = snapshotClockNs();
+    const double scale = clock.getTimeScale();
+    snapshot.stepSeconds = (scale > 0) ? clock.getFixedStep() / scale : 0.0;
+    snapshot.finished = finished;
+    snapshots.publish(snapshot);
+}
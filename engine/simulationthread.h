@@ -0,0 +1,122 @@
+#ifndef SIMULATIONTHREAD_H
+#define SIMULATIONTHREAD_H
+
+#include "gameengine.h"
+#include "simulationclock.h"
+#include "spscbuffer.h"
+#include <QtGlobal>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+// Lo que la interfaz necesita para dibujar un cuadro: los proyectiles en
+// los dos ultimos pasos y el estado de la partida. Es inmutable una vez
+// publicado y trivialmente copiable.
+struct RenderSnapshot
+{
+    static constexpr int maxProjectiles = GameEngine::maxProjectiles;
+
+    quint64 shot = 0;             // Disparo al que pertenece (empieza en 1)
+    int step = 0;                 // Pasos simulados del disparo
+    int projectileCount = 0;
+    QPointF previous[maxProjectiles];
+    QPointF current[maxProjectiles];
+    bool active[maxProjectiles] = {};
+
+    qint64 publishedNs = 0;       // Momento de la publicacion (reloj monotono)
+    double stepSeconds = 0.016;   // Tiempo real que dura un paso fijo
+
+    int currentPlayer = 1;
+    bool gameOver = false;
+    int winner = 0;
+    bool finished = false;        // El disparo termino y el motor se puede recoger
+};
+
+static_assert(std::is_trivially_copyable<RenderSnapshot>::value, "RenderSnapshot se copia con memcpy");
+
+// Copia de engine para dibujar; previous son las posiciones del paso anterior
+void captureSnapshot(const GameEngine& engine, const QPointF* previous, RenderSnapshot& snapshot);
+
+// Nanosegundos de un reloj monotono, para RenderSnapshot::publishedNs
+qint64 snapshotClockNs();
+
+// Simula los disparos en un hilo propio con paso fijo y en tiempo real
+// (segun la escala de tiempo), sin depender del temporizador de la
+// interfaz. Cada paso publica un RenderSnapshot en un triple buffer y los
+// eventos del motor (con la resistencia que le queda a cada bloque
+// golpeado) en una cola; la interfaz lee los dos sin bloqueos. El hilo
+// trabaja sobre su propia copia del motor: launch() la toma del motor de la
+// interfaz y collectEngine() la devuelve cuando el disparo termina.
+class SimulationThread
+{
+public:
+    static constexpr int eventCapacity = 4096;
+
+    SimulationThread();
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // Copia engine y lanza la andanada en el hilo. Devuelve el numero del
+    // disparo (el de sus RenderSnapshot) o 0 si ya hay uno en curso. clock
+    // da el paso fijo, los subpasos y la escala de tiempo.
+    quint64 launch(const GameEngine& engine, int player, double angle, double speed,
+                int count, double spread, const SimulationClock& clock);
+
+    // Detiene el disparo en curso (si hay) y espera a que el hilo quede libre
+    void cancel();
+
+    bool isBusy() const;
+
+    // Cambia la escala de tiempo del disparo en curso
+    void setTimeScale(double scale) { timeScale.store(scale, std::memory_order_relaxed); }
+
+    // Solo desde el hilo de la interfaz
+    bool updateSnapshot() { return snapshots.update(); }
+    const RenderSnapshot& getSnapshot() const { return snapshots.latest(); }
+    bool popEvent(GameEvent& event) { return events.pop(event); }
+    long long getDroppedEvents() const { return droppedEvents.load(std::memory_order_relaxed); }
+
+    // Espera a que termine el disparo y copia el estado final del motor en
+    // engine (que conserva su receptor de eventos); false si no hay un
+    // disparo terminado sin recoger
+    bool collectEngine(GameEngine& engine);
+
+private:
+    struct LaunchRequest
+    {
+        int player;
+        double angle, speed;
+        int count;
+        double spread;
+    };
+
+    GameEngine engine;
+    SimulationClock clock;
+    LaunchRequest request;
+    quint64 shotNumber;
+
+    SnapshotBuffer<RenderSnapshot> snapshots;
+    SpscQueue<GameEvent, eventCapacity> events;
+    std::atomic<long long> droppedEvents;
+    std::atomic<double> timeScale;
+    std::atomic<bool> abortShot;
+
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    bool pending;
+    bool running;
+    bool hasResult;
+    bool stopping;
+    std::thread worker;
+
+    static void collect(void* context, const GameEvent& event);
+    void run();
+    void simulateShot();
+    void publish(const QPointF* previous, bool finished);
+};
+
+#endif // SIMULATIONTHREAD_H
@@ -0,0 +1,152 @@
+#include "spatialgrid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid()
+    : cellSize(64), columns(0), rows(0), queryStamp(0)
+{
+}
+
+void SpatialGrid::cellRange(const QRectF& area, int& c0, int& r0, int& c1, int& r1) const
+{
+    auto column = [&](double x) {
+        return std::max(0, std::min(columns - 1, static_cast<int>(std::floor((x - bounds.left()) / cellSize))));
+    };
+    auto row = [&](double y) {
+        return std::max(0, std::min(rows - 1, static_cast<int>(std::floor((y - bounds.top()) / cellSize))));
+    };
+
+    c0 = column(area.left());
+    c1 = column(area.right());
+    r0 = row(area.top());
+    r1 = row(area.bottom());
+}
+
+void SpatialGrid::build(const QRectF& area, const QVector<Infrastructure>& blocks)
+{
+    bounds = area;
+
+    // Celdas del tamaño medio de los bloques: cada bloque ocupa pocas celdas
+    // y cada celda tiene pocos bloques
+    double total = 0;
+    int live = 0;
+    for (const Infrastructure& block : blocks) {
+        if (block.isDestroyed()) continue;
+        total += std::max(block.getRect().width(), block.getRect().height());
+        live++;
+    }
+    cellSize = live > 0 ? std::max(8.0, std::min(256.0, total / live)) : 64.0;
+
+    columns = std::max(1, static_cast<int>(std::ceil(bounds.width() / cellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil(bounds.height() / cellSize)));
+
+    const int cells = columns * rows;
+    cellStart.assign(cells + 1, 0);
+    cellCount.assign(cells, 0);
+
+    // Primera pasada: contar; segunda: repartir (almacenamiento compacto)
+    int c0, r0, c1, r1;
+    for (const Infrastructure& block : blocks) {
+        if (block.isDestroyed()) continue;
+        cellRange(block.getRect(), c0, r0, c1, r1);
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                cellStart[r * columns + c + 1]++;
+            }
+        }
+    }
+    for (int c = 0; c < cells; ++c) {
+        cellStart[c + 1] += cellStart[c];
+    }
+
+    items.assign(cellStart[cells], -1);
+    for (int i = 0; i < blocks.size(); ++i) {
+        if (blocks[i].isDestroyed()) continue;
+        cellRange(blocks[i].getRect(), c0, r0, c1, r1);
+        for (int r = r0; r <= r1; ++r) {
+            for (int c = c0; c <= c1; ++c) {
+                int cell = r * columns + c;
+                items[cellStart[cell] + cellCount[cell]++] = i;
+            }
+        }
+    }
+
+    stamps.assign(blocks.size(), 0);
+    queryStamp = 0;
+}
+
+void SpatialGrid::remove(int index, const QRectF& rect)
+{
+    if (columns == 0) return;
+
+    int c0, r0, c1, r1;
+    cellRange(rect, c0, r0, c1, r1);
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            int cell = r * columns + c;
+            int* first = items.data() + cellStart[cell];
+            int& count = cellCount[cell];
+
+            // Cambiar por el ultimo de la celda: O(bloques en la celda)
+            for (int k = 0; k < count; ++k) {
+                if (first[k] == index) {
+                    first[k] = first[--count];
+                    break;
+                }
+            }
+        }
+    }
+}
+
+bool SpatialGrid::restore(int index, const QRectF& rect)
+{
+    if (columns == 0) return false;
+
+    int c0, r0, c1, r1;
+    cellRange(rect, c0, r0, c1, r1);
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            int cell = r * columns + c;
+            if (cellStart[cell] + cellCount[cell] == cellStart[cell + 1]) return false;
+        }
+    }
+
+    // El orden dentro de la celda no importa: query() ordena los indices
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            int cell = r * columns + c;
+            items[cellStart[cell] + cellCount[cell]++] = index;
+        }
+    }
+    return true;
+}
+
+void SpatialGrid::query(const QRectF& area, std::vector<int>& out) const
+{
+    out.clear();
+    if (columns == 0) return;
+
+    if (++queryStamp == 0) {
+        std::fill(stamps.begin(), stamps.end(), 0);
+        queryStamp = 1;
+    }
+
+    int c0, r0, c1, r1;
+    cellRange(area, c0, r0, c1, r1);
+    for (int r = r0; r <= r1; ++r) {
+        for (int c = c0; c <= c1; ++c) {
+            int cell = r * columns + c;
+            const int* first = items.data() + cellStart[cell];
+            for (int k = 0; k < cellCount[cell]; ++k) {
+                int index = first[k];
+                if (stamps[index] != queryStamp) {
+                    stamps[index] = queryStamp;
+                    out.push_back(index);
+                }
+            }
+        }
+    }
+
+    // Mismo orden que recorrer todo el vector de bloques
+    std::sort(out.begin(), out.end());
+}
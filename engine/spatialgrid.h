@@ -0,0 +1,52 @@
+#ifndef SPATIALGRID_H
+#define SPATIALGRID_H
+
+#include "infrastructure.h"
+#include <QRectF>
+#include <QVector>
+#include <vector>
+
+// Rejilla uniforme de bloques para consultar solo los que estan cerca del
+// proyectil. Las celdas se guardan en arreglos planos (inicio y cantidad por
+// celda) para que copiar la rejilla entre motores del mismo escenario
+// reutilice la memoria en vez de reservarla. Quitar un bloque destruido y
+// volver a ponerlo es incremental; al agregar bloques hay que reconstruirla
+// con build().
+class SpatialGrid
+{
+public:
+    SpatialGrid();
+
+    // Reconstruye la rejilla que cubre area con los bloques no destruidos;
+    // los que quedan fuera de area caen en las celdas del borde
+    void build(const QRectF& area, const QVector<Infrastructure>& blocks);
+
+    void remove(int index, const QRectF& rect);
+
+    // Vuelve a poner un bloque quitado con remove(). Solo hay lugar en sus
+    // celdas si estaba en pie en build(); si no, devuelve false sin cambiar
+    // nada y hay que reconstruir la rejilla.
+    bool restore(int index, const QRectF& rect);
+
+    // Indices (sin repetir y en orden creciente) de los bloques cuyas
+    // celdas toca area
+    void query(const QRectF& area, std::vector<int>& out) const;
+
+    double getCellSize() const { return cellSize; }
+
+private:
+    QRectF bounds;
+    double cellSize;
+    int columns, rows;
+
+    std::vector<int> cellStart;  // Primer elemento de cada celda en items
+    std::vector<int> cellCount;  // Bloques vivos de cada celda
+    std::vector<int> items;      // Indices de bloque agrupados por celda
+
+    mutable std::vector<unsigned> stamps;  // Ultima consulta que vio cada bloque
+    mutable unsigned queryStamp;
+
+    void cellRange(const QRectF& area, int& c0, int& r0, int& c1, int& r1) const;
+};
+
+#endif // SPATIALGRID_H
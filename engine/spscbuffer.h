@@ -0,0 +1,100 @@
+#ifndef SPSCBUFFER_H
+#define SPSCBUFFER_H
+
+#include <atomic>
+#include <type_traits>
+
+// Estructuras sin bloqueos para pasar datos de un hilo productor a un hilo
+// consumidor (exactamente uno de cada lado). Ninguna reserva memoria ni
+// espera al otro hilo.
+
+// Cola circular de capacidad fija (potencia de dos). push() devuelve false
+// si esta llena; el productor decide si descarta.
+template <typename T, int Capacity>
+class SpscQueue
+{
+    static_assert((Capacity & (Capacity - 1)) == 0, "La capacidad debe ser potencia de dos");
+    static_assert(std::is_trivially_copyable<T>::value, "Los elementos se copian sin constructor");
+
+public:
+    SpscQueue() : head(0), tail(0) {}
+
+    // Solo el productor
+    bool push(const T& item)
+    {
+        const unsigned t = tail.load(std::memory_order_relaxed);
+        if (t - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        items[t & (Capacity - 1)] = item;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Solo el consumidor
+    bool pop(T& item)
+    {
+        const unsigned h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = items[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Solo el consumidor, con el productor detenido
+    void clear() { head.store(tail.load(std::memory_order_acquire), std::memory_order_release); }
+
+private:
+    T items[Capacity];
+
+    // En lineas de cache distintas para que los dos hilos no se estorben
+    alignas(64) std::atomic<unsigned> head;  // Siguiente a leer (consumidor)
+    alignas(64) std::atomic<unsigned> tail;  // Siguiente a escribir (productor)
+};
+
+// Triple buffer: el productor publica versiones completas y el consumidor
+// lee siempre la mas reciente. Ninguno espera al otro y el consumidor nunca
+// ve una version a medio escribir; las versiones intermedias que nadie leyo
+// se pierden.
+template <typename T>
+class SnapshotBuffer
+{
+public:
+    SnapshotBuffer() : middle(1), back(0), front(2), received(false) {}
+
+    // Solo el productor: copia value y lo deja como la version mas reciente
+    void publish(const T& value)
+    {
+        buffers[back] = value;
+        back = middle.exchange(back | freshBit, std::memory_order_acq_rel) & indexMask;
+    }
+
+    // Solo el consumidor: true si llego una version nueva desde la ultima llamada
+    bool update()
+    {
+        if ((middle.load(std::memory_order_relaxed) & freshBit) == 0) {
+            return false;
+        }
+        front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+        received = true;
+        return true;
+    }
+
+    // Solo el consumidor: la ultima version recibida con update()
+    const T& latest() const { return buffers[front]; }
+    bool hasValue() const { return received; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int freshBit = 4;
+
+    T buffers[3];
+    std::atomic<int> middle;  // Buffer intercambiable y si tiene una version sin leer
+    int back;                 // Del productor
+    int front;                // Del consumidor
+    bool received;
+};
+
+#endif // SPSCBUFFER_H
@@ -0,0 +1,311 @@
+#include "statehistory.h"
+#include <algorithm>
+
+StateHistory::StateHistory(int keyframeInterval, size_t maxBytes)
+    : keyframeInterval(std::max(1, keyframeInterval)), maxBytes(maxBytes), bytes(0), current(0),
+    player1Blocks(0), mirrorVersion(0)
+{
+}
+
+void StateHistory::clear()
+{
+    segments.clear();
+    bytes = 0;
+    current = 0;
+    player1Blocks = 0;
+    mirror.clear();
+    mirrorVersion = 0;
+    touchedSlot.clear();
+    touched.clear();
+    changed.clear();
+}
+
+void StateHistory::begin(const GameEngine& engine)
+{
+    clear();
+
+    const QVector<Infrastructure>& blocks1 = engine.getPlayer1Infrastructure();
+    const QVector<Infrastructure>& blocks2 = engine.getPlayer2Infrastructure();
+    player1Blocks = blocks1.size();
+    mirror.reserve(blocks1.size() + blocks2.size());
+    for (const Infrastructure& block : blocks1) mirror.push_back(block.getResistance());
+    for (const Infrastructure& block : blocks2) mirror.push_back(block.getResistance());
+    mirrorVersion = engine.getLayoutVersion();
+    touchedSlot.assign(mirror.size(), -1);
+
+    Frame frame = {0.0, 0, 1, engine.getCurrentPlayer(), engine.getShotStats().steps};
+    startSegment(engine, frame);
+}
+
+void StateHistory::recordStep(const GameEngine& engine, double dt)
+{
+    record(engine, dt, false);
+}
+
+void StateHistory::recordInput(const GameEngine& engine)
+{
+    record(engine, 0.0, true);
+}
+
+void StateHistory::record(const GameEngine& engine, double dt, bool input)
+{
+    const int blockCount = engine.getPlayer1Infrastructure().size() + engine.getPlayer2Infrastructure().size();
+    if (segments.empty() || int(mirror.size()) != blockCount) {
+        begin(engine);
+        return;
+    }
+
+    // Despues de retroceder, lo grabado desde ahi deja de valer
+    truncate(current);
+
+    const Frame& last = segments.back().frames.back();
+    const int steps = engine.getShotStats().steps;
+    if (!input && steps == last.step) {
+        return;  // update() sin proyectiles en vuelo no cambio nada
+    }
+    findChanges(engine);
+
+    const int player = engine.getCurrentPlayer();
+    Frame frame = {dt, -1, last.turn + (player != last.player ? 1 : 0), player, steps};
+
+    if (int(segments.back().frames.size()) >= keyframeInterval) {
+        startSegment(engine, frame);
+    } else {
+        Segment& segment = segments.back();
+        if (input) {
+            segment.deltas.push_back(addDelta(segment, engine, false));
+            frame.delta = int(segment.deltas.size()) - 1;
+        }
+        segment.frames.push_back(frame);
+
+        bytes -= segment.bytes;
+        measure(segment);
+        bytes += segment.bytes;
+    }
+
+    current = getLastFrame();
+    evict();
+}
+
+void StateHistory::findChanges(const GameEngine& engine)
+{
+    // La version solo cambia si cambio alguna resistencia: en los pasos sin
+    // golpes no hace falta recorrer los bloques
+    changed.clear();
+    if (engine.getLayoutVersion() == mirrorVersion) return;
+
+    auto compare = [this](const QVector<Infrastructure>& blocks, int offset) {
+        for (int i = 0; i < blocks.size(); ++i) {
+            const double resistance = blocks[i].getResistance();
+            const int block = offset + i;
+            if (resistance == mirror[block]) continue;
+
+            if (touchedSlot[block] < 0) {
+                touchedSlot[block] = int(touched.size());
+                touched.push_back({block, mirror[block]});
+            }
+            mirror[block] = resistance;
+            changed.push_back(block);
+        }
+    };
+    compare(engine.getPlayer1Infrastructure(), 0);
+    compare(engine.getPlayer2Infrastructure(), player1Blocks);
+    mirrorVersion = engine.getLayoutVersion();
+}
+
+StateHistory::Delta StateHistory::addDelta(Segment& segment, const GameEngine& engine, bool keyframe)
+{
+    Delta delta;
+    delta.changeBegin = int(segment.changes.size());
+    if (keyframe) {
+        for (const BlockValue& block : touched) {
+            segment.changes.push_back({block.block, mirror[block.block]});
+        }
+    } else {
+        for (int block : changed) {
+            segment.changes.push_back({block, mirror[block]});
+        }
+    }
+    delta.changeCount = int(segment.changes.size()) - delta.changeBegin;
+
+    delta.projectileBegin = int(segment.projectiles.size());
+    delta.projectileCount = engine.getProjectileCount();
+    for (int i = 0; i < delta.projectileCount; ++i) {
+        segment.projectiles.push_back(engine.getProjectile(i));
+    }
+
+    delta.stats = engine.getShotStats();
+    delta.player = engine.getCurrentPlayer();
+    delta.gameOver = engine.isGameOver();
+    delta.winner = engine.getWinner();
+    return delta;
+}
+
+void StateHistory::startSegment(const GameEngine& engine, const Frame& frame)
+{
+    Segment segment;
+    segment.firstFrame = segments.empty() ? 0 : getLastFrame() + 1;
+    segment.frames.reserve(keyframeInterval);
+    segment.deltas.push_back(addDelta(segment, engine, true));
+    segment.frames.push_back(frame);
+    segment.frames.back().delta = 0;
+    measure(segment);
+
+    bytes += segment.bytes;
+    segments.push_back(std::move(segment));
+}
+
+void StateHistory::truncate(int frame)
+{
+    if (segments.empty() || frame >= getLastFrame()) return;
+
+    while (segments.back().firstFrame > frame) {
+        bytes -= segments.back().bytes;
+        segments.pop_back();
+    }
+
+    Segment& segment = segments.back();
+    const int keep = frame - segment.firstFrame + 1;
+    segment.frames.erase(segment.frames.begin() + keep, segment.frames.end());
+
+    int lastDelta = 0;
+    for (int i = keep - 1; i > 0; --i) {
+        if (segment.frames[i].delta >= 0) {
+            lastDelta = segment.frames[i].delta;
+            break;
+        }
+    }
+    const Delta& delta = segment.deltas[lastDelta];
+    segment.changes.erase(segment.changes.begin() + delta.changeBegin + delta.changeCount, segment.changes.end());
+    segment.projectiles.erase(segment.projectiles.begin() + delta.projectileBegin + delta.projectileCount,
+                              segment.projectiles.end());
+    segment.deltas.erase(segment.deltas.begin() + lastDelta + 1, segment.deltas.end());
+
+    bytes -= segment.bytes;
+    measure(segment);
+    bytes += segment.bytes;
+}
+
+void StateHistory::evict()
+{
+    // El tramo del cuadro actual nunca se descarta
+    while (bytes > maxBytes && segments.size() > 1 && segments[1].firstFrame <= current) {
+        bytes -= segments.front().bytes;
+        segments.pop_front();
+    }
+}
+
+void StateHistory::measure(Segment& segment)
+{
+    segment.bytes = sizeof(Segment) +
+                    segment.frames.capacity() * sizeof(Frame) +
+                    segment.deltas.capacity() * sizeof(Delta) +
+                    segment.changes.capacity() * sizeof(BlockValue) +
+                    segment.projectiles.capacity() * sizeof(Projectile);
+}
+
+void StateHistory::setMaxBytes(size_t limit)
+{
+    maxBytes = limit;
+    evict();
+}
+
+size_t StateHistory::getBytes() const
+{
+    return bytes + mirror.capacity() * sizeof(double) + touchedSlot.capacity() * sizeof(int) +
+           touched.capacity() * sizeof(BlockValue) + changed.capacity() * sizeof(int);
+}
+
+int StateHistory::getLastFrame() const
+{
+    if (segments.empty()) return 0;
+    const Segment& last = segments.back();
+    return last.firstFrame + int(last.frames.size()) - 1;
+}
+
+const StateHistory::Segment* StateHistory::findSegment(int frame) const
+{
+    if (segments.empty() || frame < getFirstFrame() || frame > getLastFrame()) return nullptr;
+
+    auto after = std::upper_bound(segments.begin(), segments.end(), frame,
+                                  [](int value, const Segment& segment) { return value < segment.firstFrame; });
+    return &*(after - 1);
+}
+
+StateHistory::FrameInfo StateHistory::getFrameInfo(int frame) const
+{
+    const Segment* segment = findSegment(frame);
+    if (!segment) return FrameInfo{0, 0, 0, false};
+
+    const Frame& entry = segment->frames[frame - segment->firstFrame];
+    return FrameInfo{entry.turn, entry.player, entry.step, entry.delta >= 0};
+}
+
+bool StateHistory::seek(GameEngine& engine, int frame)
+{
+    const Segment* segment = findSegment(frame);
+    if (!segment) return false;
+
+    // Los eventos de volver a simular no son de la partida
+    const GameEventCallback callback = engine.getEventCallback();
+    void* const context = engine.getEventContext();
+    engine.setEventCallback(nullptr);
+
+    // Hacia adelante en el mismo tramo se sigue desde el cuadro actual si el
+    // motor no cambio desde entonces
+    int from = current;
+    const Frame* at = (current >= segment->firstFrame && current <= frame)
+                          ? &segment->frames[current - segment->firstFrame] : nullptr;
+    if (!at || engine.getLayoutVersion() != mirrorVersion ||
+        engine.getShotStats().steps != at->step || engine.getCurrentPlayer() != at->player) {
+        const Delta& key = segment->deltas[0];
+        for (int slot = key.changeCount; slot < int(touched.size()); ++slot) {
+            setBlock(engine, touched[slot].block, touched[slot].resistance);
+        }
+        apply(engine, *segment, key);
+        from = segment->firstFrame;
+    }
+
+    for (int i = from + 1; i <= frame; ++i) {
+        const Frame& entry = segment->frames[i - segment->firstFrame];
+        if (entry.delta < 0) {
+            engine.update(entry.dt);
+        } else {
+            apply(engine, *segment, segment->deltas[entry.delta]);
+        }
+    }
+    engine.setEventCallback(callback, context);
+
+    // Los bloques que nunca cambiaron siguen como en begin()
+    for (const BlockValue& block : touched) {
+        mirror[block.block] = blockResistance(engine, block.block);
+    }
+    mirrorVersion = engine.getLayoutVersion();
+    current = frame;
+    return true;
+}
+
+void StateHistory::apply(GameEngine& engine, const Segment& segment, const Delta& delta) const
+{
+    for (int i = 0; i < delta.changeCount; ++i) {
+        const BlockValue& change = segment.changes[delta.changeBegin + i];
+        setBlock(engine, change.block, change.resistance);
+    }
+    engine.restoreMatch(segment.projectiles.data() + delta.projectileBegin, delta.projectileCount,
+                        delta.stats, delta.player, delta.gameOver, delta.winner);
+}
+
+void StateHistory::setBlock(GameEngine& engine, int block, double resistance) const
+{
+    if (block < player1Blocks) {
+        engine.setBlockResistance(1, block, resistance);
+    } else {
+        engine.setBlockResistance(2, block - player1Blocks, resistance);
+    }
+}
+
+double StateHistory::blockResistance(const GameEngine& engine, int block) const
+{
+    if (block < player1Blocks) return engine.getPlayer1Infrastructure()[block].getResistance();
+    return engine.getPlayer2Infrastructure()[block - player1Blocks].getResistance();
+}
@@ -0,0 +1,133 @@
+#ifndef STATEHISTORY_H
+#define STATEHISTORY_H
+
+#include "gameengine.h"
+#include <QtGlobal>
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+// Historial de la partida para retroceder: un cuadro por cada update() que
+// avanzo el disparo y por cada cambio que no es fisica (lanzamiento, cambio
+// de turno, el resultado de un disparo simulado en otro hilo). Cada
+// keyframeInterval cuadros se guarda un cuadro completo; entre medio, de
+// un paso de simulacion solo se guarda su dt (se vuelve a simular) y de
+// los demas cambios solo las resistencias que cambiaron y los proyectiles.
+// Los cuadros completos solo guardan los bloques que alguna vez cambiaron
+// desde begin(), asi que ocupan poco aunque el escenario sea grande.
+//
+// Cuando el historial pasa de maxBytes se descartan los cuadros mas
+// antiguos, de un cuadro completo al siguiente. Solo sirve para el motor
+// con el que se grabo (o una copia con el mismo escenario).
+class StateHistory
+{
+public:
+    struct FrameInfo
+    {
+        int turn;     // Desde 1; suma uno en cada cambio de jugador
+        int player;   // Jugador de turno
+        int step;     // Pasos del disparo en curso (ShotStats::steps)
+        bool input;   // No es un paso de simulacion
+    };
+
+    explicit StateHistory(int keyframeInterval = 120, size_t maxBytes = 8 * 1024 * 1024);
+
+    // Borra el historial y graba el estado actual del motor como cuadro 0
+    void begin(const GameEngine& engine);
+    void clear();
+
+    // Despues de cada engine.update(dt); si el update no avanzo nada no se graba
+    void recordStep(const GameEngine& engine, double dt);
+
+    // Despues de cualquier otro cambio del motor (launchVolley, switchTurn,
+    // copiar el resultado de otro hilo)
+    void recordInput(const GameEngine& engine);
+
+    // Lleva el motor al cuadro pedido: restaura el cuadro completo anterior
+    // y vuelve a simular hasta el; si el cuadro esta mas adelante en el mismo
+    // tramo sigue desde el actual. El receptor de eventos del motor se
+    // desactiva mientras tanto. Grabar despues de retroceder descarta los
+    // cuadros siguientes. Devuelve false si el cuadro ya no esta guardado.
+    bool seek(GameEngine& engine, int frame);
+
+    bool isEmpty() const { return segments.empty(); }
+    int getFirstFrame() const { return segments.empty() ? 0 : segments.front().firstFrame; }
+    int getLastFrame() const;
+    int getCurrentFrame() const { return current; }
+    FrameInfo getFrameInfo(int frame) const;
+
+    int getKeyframeInterval() const { return keyframeInterval; }
+    int getKeyframeCount() const { return static_cast<int>(segments.size()); }
+    void setMaxBytes(size_t bytes);
+    size_t getMaxBytes() const { return maxBytes; }
+    size_t getBytes() const;
+
+private:
+    // Los bloques del jugador 2 van despues de los del jugador 1
+    struct BlockValue
+    {
+        int block;
+        double resistance;
+    };
+
+    struct Delta
+    {
+        int changeBegin, changeCount;          // En Segment::changes
+        int projectileBegin, projectileCount;  // En Segment::projectiles
+        ShotStats stats;
+        int player;
+        bool gameOver;
+        int winner;
+    };
+
+    struct Frame
+    {
+        double dt;   // Del update() si delta es -1
+        int delta;   // En Segment::deltas; -1 es un paso que se vuelve a simular
+        int turn;
+        int player;
+        int step;
+    };
+
+    // Un cuadro completo (frames[0], deltas[0] con el valor de cada bloque
+    // de touched en ese orden) y los cuadros hasta el siguiente
+    struct Segment
+    {
+        int firstFrame;
+        std::vector<Frame> frames;
+        std::vector<Delta> deltas;
+        std::vector<BlockValue> changes;
+        std::vector<Projectile> projectiles;
+        size_t bytes;
+    };
+
+    std::deque<Segment> segments;
+    int keyframeInterval;
+    size_t maxBytes;
+    size_t bytes;  // De segments
+    int current;
+
+    // Resistencias del cuadro actual y los bloques que cambiaron alguna vez,
+    // con la resistencia que tenian en begin()
+    int player1Blocks;
+    std::vector<double> mirror;
+    quint64 mirrorVersion;
+    std::vector<int> touchedSlot;  // Por bloque: lugar en touched o -1
+    std::vector<BlockValue> touched;
+    std::vector<int> changed;      // Bloques que cambiaron en el ultimo cuadro
+
+    void record(const GameEngine& engine, double dt, bool input);
+    void findChanges(const GameEngine& engine);
+    Delta addDelta(Segment& segment, const GameEngine& engine, bool keyframe);
+    void startSegment(const GameEngine& engine, const Frame& frame);
+    void truncate(int frame);
+    void evict();
+    void measure(Segment& segment);
+    const Segment* findSegment(int frame) const;
+
+    void setBlock(GameEngine& engine, int block, double resistance) const;
+    void apply(GameEngine& engine, const Segment& segment, const Delta& delta) const;
+    double blockResistance(const GameEngine& engine, int block) const;
+};
+
+#endif // STATEHISTORY_H
@@ -0,0 +1,139 @@
+#include "telemetry.h"
+#include <cstring>
+
+static const char telemetryMagic[4] = {'L', '5', 'T', 'L'};
+
+TelemetryLog::TelemetryLog()
+    : queue(new SpscQueue<TelemetryRecord, queueCapacity>()),
+    opened(false), sequence(0), match(0), shot(0), dropped(0),
+    stopping(false), written(0), file(QString()),
+    segment(nullptr), segmentIndex(0), segmentUsed(0)
+{
+}
+
+TelemetryLog::~TelemetryLog()
+{
+    close();
+}
+
+bool TelemetryLog::open(const QString& path, double damageFactor, double projectileMass)
+{
+    close();
+
+    // El mapeo escribe en el archivo, asi que tambien hay que poder leerlo
+    file.setFileName(path);
+    if (!file.open(QIODevice::ReadWrite | QIODevice::Truncate)) {
+        return false;
+    }
+    if (!mapSegment(0)) {
+        file.close();
+        return false;
+    }
+
+    TelemetryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, telemetryMagic, 4);
+    header.version = formatVersion;
+    header.recordSize = sizeof(TelemetryRecord);
+    header.damageFactor = damageFactor;
+    header.projectileMass = projectileMass;
+    header.startedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    std::memcpy(segment, &header, sizeof(header));
+    segmentUsed = sizeof(header);
+
+    queue->clear();
+    sequence = 0;
+    match = 0;
+    shot = 0;
+    dropped.store(0, std::memory_order_relaxed);
+    written.store(0, std::memory_order_relaxed);
+    started = std::chrono::steady_clock::now();
+
+    stopping.store(false, std::memory_order_relaxed);
+    flusher = std::thread([this]() { flushLoop(); });
+    opened = true;
+    return true;
+}
+
+void TelemetryLog::close()
+{
+    if (flusher.joinable()) {
+        stopping.store(true, std::memory_order_release);
+        flusher.join();
+    }
+    opened = false;
+
+    if (segment) {
+        file.unmap(segment);
+        segment = nullptr;
+        file.resize(segmentIndex * segmentBytes + segmentUsed);
+    }
+    file.close();
+}
+
+void TelemetryLog::beginMatch(quint32 number)
+{
+    if (!opened) return;
+    match = number;
+    shot = 0;
+
+    TelemetryRecord entry;
+    std::memset(&entry, 0, sizeof(entry));
+    entry.sequence = ++sequence;
+    entry.match = match;
+    entry.type = telemetryMatchStart;
+    entry.side = -1;
+    entry.index = -1;
+    push(entry);
+}
+
+void TelemetryLog::flushLoop()
+{
+    TelemetryRecord entry;
+    for (;;) {
+        // Se lee antes de vaciar la cola: lo que se encolo antes de close()
+        // se escribe en esta vuelta
+        const bool stop = stopping.load(std::memory_order_acquire);
+
+        // Un solo vistazo al reloj por tanda
+        const qint64 now = elapsedNs();
+        int count = 0;
+        while (queue->pop(entry)) {
+            entry.timeNs = now;
+            write(entry);
+            count++;
+        }
+        if (stop) return;
+
+        // Sin eventos se espera un poco en vez de despertar al hilo que
+        // simula: el productor nunca se bloquea ni avisa
+        if (count == 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void TelemetryLog::write(const TelemetryRecord& entry)
+{
+    if (segmentUsed == segmentBytes && !mapSegment(segmentIndex + 1)) {
+        return;  // Sin espacio en disco: el registro queda hasta el ultimo segmento
+    }
+    std::memcpy(segment + segmentUsed, &entry, sizeof(entry));
+    segmentUsed += sizeof(entry);
+    written.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool TelemetryLog::mapSegment(qint64 index)
+{
+    if (!file.resize((index + 1) * segmentBytes)) return false;
+
+    uchar* next = file.map(index * segmentBytes, segmentBytes);
+    if (!next) return false;
+
+    if (segment) file.unmap(segment);
+    segment = next;
+    segmentIndex = index;
+    segmentUsed = 0;
+    return true;
+}
@@ -0,0 +1,162 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include "gameevents.h"
+#include "spscbuffer.h"
+#include <QFile>
+#include <QString>
+#include <QtGlobal>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+// Formato del registro de telemetria (.l5t): una TelemetryHeader y despues
+// un TelemetryRecord por evento, en el orden de bytes del equipo como los
+// niveles empaquetados. Los registros se numeran desde 1 en sequence; un
+// hueco en la numeracion son eventos que se descartaron porque la cola
+// estaba llena, y un registro con sequence 0 marca el final (si el programa
+// termina sin cerrar el registro, el resto del ultimo segmento queda en ceros).
+struct TelemetryHeader
+{
+    char magic[4];          // "L5TL"
+    quint32 version;
+    quint32 recordSize;     // sizeof(TelemetryRecord)
+    quint32 reserved;
+    double damageFactor;    // Del motor que genero los eventos: el daño de un
+    double projectileMass;  // impacto es damageFactor * masa * rapidez
+    qint64 startedMs;       // Apertura del registro (ms desde 1970, UTC)
+    char padding[24];
+};
+
+// Tipo de los registros que no son un GameEvent: empieza una partida
+static constexpr quint8 telemetryMatchStart = 0xff;
+
+struct TelemetryRecord
+{
+    qint64 timeNs;        // Desde la apertura del registro hasta que se escribio (el hilo
+                          // que simula no lee el reloj: el orden exacto lo dan sequence y step)
+    quint32 sequence;
+    quint32 match;        // La de beginMatch()
+    quint32 shot;         // Disparo de la partida, desde 1 (0 antes del primero)
+    quint8 type;          // GameEventType o telemetryMatchStart
+    qint8 player;
+    qint8 side;
+    quint8 projectile;
+    qint32 index;
+    qint32 step;
+    double damage;        // Resistencia quitada (InfrastructureHit)
+    double resistance;    // Resistencia que le queda al bloque (InfrastructureHit)
+    float x, y;           // Posicion del proyectil
+    float vx, vy;         // Velocidad justo antes del evento
+};
+
+static_assert(sizeof(TelemetryHeader) == 64, "La cabecera se escribe tal cual");
+static_assert(sizeof(TelemetryRecord) == 64, "Un registro por linea de cache");
+static_assert(std::is_trivially_copyable<TelemetryRecord>::value, "Los registros se copian con memcpy");
+
+// Registro binario de solo agregar con todos los eventos del motor. El
+// hilo que simula solo arma el registro y lo deja en una cola sin bloqueos;
+// un hilo propio lo copia a un segmento del archivo mapeado en memoria
+// (segmentBytes) y al llenarlo agranda el archivo y mapea el siguiente. Si
+// la cola se llena el evento se descarta y se cuenta en getDropped().
+//
+// record() y beginMatch() solo desde un hilo a la vez (el que simula):
+// se registra en el motor con setEventCallback(TelemetryLog::collect, &log).
+class TelemetryLog
+{
+public:
+    static constexpr quint32 formatVersion = 1;
+    static constexpr int queueCapacity = 16384;
+    static constexpr qint64 segmentBytes = 1 << 20;
+
+    TelemetryLog();
+    ~TelemetryLog();
+
+    TelemetryLog(const TelemetryLog&) = delete;
+    TelemetryLog& operator=(const TelemetryLog&) = delete;
+
+    // Crea (o vacia) path y arranca el hilo que escribe. damageFactor y
+    // projectileMass se guardan en la cabecera (GameEngine::getDamageFactor()).
+    bool open(const QString& path, double damageFactor, double projectileMass);
+
+    // Escribe lo que quede en la cola, recorta el archivo a lo escrito y lo cierra
+    void close();
+    bool isOpen() const { return opened; }
+
+    // Empieza una partida: los eventos siguientes llevan match y el
+    // contador de disparos vuelve a 0
+    void beginMatch(quint32 match);
+
+    void record(const GameEvent& event)
+    {
+        if (!opened) return;
+        if (event.type == GameEventType::Launch && event.projectile == 0) shot++;
+
+        TelemetryRecord entry;
+        entry.timeNs = 0;
+        entry.sequence = ++sequence;
+        entry.match = match;
+        entry.shot = shot;
+        entry.type = static_cast<quint8>(event.type);
+        entry.player = static_cast<qint8>(event.player);
+        entry.side = static_cast<qint8>(event.side);
+        entry.projectile = static_cast<quint8>(event.projectile);
+        entry.index = event.index;
+        entry.step = event.step;
+        entry.damage = event.damage;
+        entry.resistance = event.resistance;
+        entry.x = static_cast<float>(event.position.x());
+        entry.y = static_cast<float>(event.position.y());
+        entry.vx = static_cast<float>(event.velocity.x());
+        entry.vy = static_cast<float>(event.velocity.y());
+        push(entry);
+    }
+
+    // Adaptador para GameEngine::setEventCallback
+    static void collect(void* context, const GameEvent& event)
+    {
+        static_cast<TelemetryLog*>(context)->record(event);
+    }
+
+    long long getDropped() const { return dropped.load(std::memory_order_relaxed); }
+    long long getWritten() const { return written.load(std::memory_order_relaxed); }
+
+private:
+    std::unique_ptr<SpscQueue<TelemetryRecord, queueCapacity>> queue;
+    bool opened;
+    quint32 sequence;
+    quint32 match;
+    quint32 shot;
+    std::chrono::steady_clock::time_point started;
+    std::atomic<long long> dropped;  // Solo lo modifica el productor
+
+    // Del hilo que escribe
+    std::thread flusher;
+    std::atomic<bool> stopping;
+    std::atomic<long long> written;
+    QFile file;
+    uchar* segment;
+    qint64 segmentIndex;
+    qint64 segmentUsed;
+
+    qint64 elapsedNs() const
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - started).count();
+    }
+
+    void push(const TelemetryRecord& entry)
+    {
+        if (!queue->push(entry)) {
+            dropped.store(dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
+    }
+
+    void flushLoop();
+    void write(const TelemetryRecord& entry);
+    bool mapSegment(qint64 index);
+};
+
+#endif // TELEMETRY_H
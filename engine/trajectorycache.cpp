@@ -0,0 +1,99 @@
+#include "trajectorycache.h"
+#include <functional>
+
+size_t TrajectoryCache::KeyHash::operator()(const Key& key) const
+{
+    size_t hash = std::hash<double>()(key.angle);
+    hash = hash * 31 + std::hash<double>()(key.speed);
+    hash = hash * 31 + std::hash<double>()(key.dt);
+    hash = hash * 31 + std::hash<int>()(key.player);
+    hash = hash * 31 + std::hash<quint64>()(key.version);
+    return hash;
+}
+
+TrajectoryCache::TrajectoryCache(size_t maxBytes)
+    : maxBytes(maxBytes), bytes(0), hits(0), misses(0)
+{
+}
+
+QVector<QPointF> TrajectoryCache::trace(const GameEngine& state, double angle, double speed, double dt)
+{
+    const Key key = {angle, speed, dt, state.getCurrentPlayer(), state.getLayoutVersion()};
+
+    auto found = index.find(key);
+    if (found != index.end()) {
+        hits++;
+        entries.splice(entries.begin(), entries, found->second);
+        return found->second->points;
+    }
+    misses++;
+
+    // Un golpe cambio el escenario: ningun recorrido guardado vuelve a servir.
+    // Un cambio de turno sin daño no toca la version, pero la copia tiene que
+    // ser del jugador de turno: los choques y el golpe al rival dependen de el
+    const bool layoutChanged = !base || base->getLayoutVersion() != key.version;
+    if (layoutChanged || base->getCurrentPlayer() != key.player) {
+        if (layoutChanged) clear();
+        base.reset(new GameEngine(state));
+        base->buildSpatialIndex();
+        engine.reset(new GameEngine(*base));
+        base->snapshot(start, startResistance);
+    }
+
+    QVector<QPointF> points = simulate(state, angle, speed, dt);
+    points.squeeze();
+
+    Entry entry = {key, points, sizeof(Entry) + points.capacity() * sizeof(QPointF)};
+    if (entry.bytes <= maxBytes) {
+        evict(maxBytes - entry.bytes);
+        bytes += entry.bytes;
+        entries.push_front(entry);
+        index[key] = entries.begin();
+    }
+    return points;
+}
+
+QVector<QPointF> TrajectoryCache::simulate(const GameEngine& state, double angle, double speed, double dt)
+{
+    if (!engine->restore(start, startResistance.data())) {
+        *engine = *base;
+    }
+
+    // La copia es del jugador de turno de state (ver trace())
+    engine->launchProjectile(state.getCurrentPlayer(), angle, speed);
+    const Projectile& projectile = engine->getProjectile(0);
+
+    QVector<QPointF> points;
+    points.reserve(256);
+    points.append(projectile.getPosition());
+    for (int step = 0; step < maxPoints && engine->update(dt); ++step) {
+        points.append(projectile.getPosition());
+    }
+    if (points.size() <= maxPoints) {
+        points.append(projectile.getPosition());
+    }
+    return points;
+}
+
+void TrajectoryCache::setMaxBytes(size_t limit)
+{
+    maxBytes = limit;
+    evict(maxBytes);
+}
+
+void TrajectoryCache::clear()
+{
+    entries.clear();
+    index.clear();
+    bytes = 0;
+}
+
+void TrajectoryCache::evict(size_t limit)
+{
+    while (bytes > limit && !entries.empty()) {
+        const Entry& oldest = entries.back();
+        bytes -= oldest.bytes;
+        index.erase(oldest.key);
+        entries.pop_back();
+    }
+}
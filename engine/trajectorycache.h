@@ -0,0 +1,87 @@
+#ifndef TRAJECTORYCACHE_H
+#define TRAJECTORYCACHE_H
+
+#include "gameengine.h"
+#include <QPointF>
+#include <QVector>
+#include <QtGlobal>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+// Recorridos de la vista previa del disparo. Mientras se arrastra un slider
+// se pide el recorrido en cada valor, asi que se guardan los ultimos por
+// (angulo, velocidad, jugador, dt, version del escenario) y se descartan
+// los usados hace mas tiempo cuando superan maxBytes. Los recorridos solo
+// dejan de valer cuando cambia la resistencia de algun bloque
+// (GameEngine::getLayoutVersion()); entonces se descartan todos.
+class TrajectoryCache
+{
+public:
+    static constexpr int maxPoints = 4096;  // Pasos por recorrido como maximo
+
+    explicit TrajectoryCache(size_t maxBytes = 4 * 1024 * 1024);
+
+    // Posiciones del proyectil en cada paso de dt de un disparo del jugador
+    // actual de state, desde el cañon hasta que se detiene. Si no esta
+    // guardado se simula en una copia del motor; state no se modifica.
+    QVector<QPointF> trace(const GameEngine& state, double angle, double speed, double dt = 0.016);
+
+    void setMaxBytes(size_t bytes);
+    size_t getMaxBytes() const { return maxBytes; }
+    size_t getBytes() const { return bytes; }
+    int getEntryCount() const { return static_cast<int>(entries.size()); }
+    long long getHits() const { return hits; }
+    long long getMisses() const { return misses; }
+    void clear();
+
+private:
+    struct Key
+    {
+        double angle;
+        double speed;
+        double dt;
+        int player;
+        quint64 version;
+
+        bool operator==(const Key& other) const
+        {
+            return angle == other.angle && speed == other.speed && dt == other.dt &&
+                   player == other.player && version == other.version;
+        }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry
+    {
+        Key key;
+        QVector<QPointF> points;
+        size_t bytes;
+    };
+
+    // De la usada mas recientemente a la mas antigua
+    std::list<Entry> entries;
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    size_t maxBytes;
+    size_t bytes;
+    long long hits;
+    long long misses;
+
+    // Motor de trabajo que se reinicia antes de cada recorrido desde la copia
+    // del escenario de la version y el jugador de turno guardados
+    std::unique_ptr<GameEngine> base;
+    std::unique_ptr<GameEngine> engine;
+    GameState start;
+    std::vector<double> startResistance;
+
+    void evict(size_t limit);
+    QVector<QPointF> simulate(const GameEngine& state, double angle, double speed, double dt);
+};
+
+#endif // TRAJECTORYCACHE_H
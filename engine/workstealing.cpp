@@ -0,0 +1,109 @@
+#include "workstealing.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+static quint64 packRange(quint32 begin, quint32 end)
+{
+    return (quint64(begin) << 32) | end;
+}
+
+static quint32 rangeBegin(quint64 bounds) { return quint32(bounds >> 32); }
+static quint32 rangeEnd(quint64 bounds) { return quint32(bounds); }
+
+WorkStealingScheduler::WorkStealingScheduler(int threads)
+    : threadCount(threads), steals(0)
+{
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::thread::hardware_concurrency());
+    }
+    threadCount = std::max(1, threadCount);
+    ranges.reset(new Range[threadCount]);
+}
+
+void WorkStealingScheduler::run(int count, const std::function<void(int index, int worker)>& body)
+{
+    steals.store(0, std::memory_order_relaxed);
+    if (count <= 0) return;
+
+    // Tramos iniciales contiguos del mismo tamaño (los primeros con uno mas)
+    const int workers = std::min(threadCount, count);
+    for (int w = 0; w < threadCount; ++w) {
+        quint32 begin = quint32(qint64(count) * w / workers);
+        quint32 end = quint32(qint64(count) * (w + 1) / workers);
+        if (w >= workers) begin = end = quint32(count);
+        ranges[w].bounds.store(packRange(begin, end), std::memory_order_relaxed);
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (int w = 1; w < workers; ++w) {
+        threads.emplace_back([this, w, &body]() { work(w, body); });
+    }
+    work(0, body);
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingScheduler::work(int worker, const std::function<void(int, int)>& body)
+{
+    int index;
+    for (;;) {
+        if (takeOwn(worker, index) || steal(worker, index)) {
+            body(index, worker);
+        } else {
+            // Todos los tramos estan vacios; lo que otro hilo acaba de robar
+            // lo termina el mismo
+            return;
+        }
+    }
+}
+
+bool WorkStealingScheduler::takeOwn(int worker, int& index)
+{
+    std::atomic<quint64>& bounds = ranges[worker].bounds;
+    quint64 current = bounds.load(std::memory_order_acquire);
+    for (;;) {
+        quint32 begin = rangeBegin(current);
+        quint32 end = rangeEnd(current);
+        if (begin >= end) return false;
+
+        if (bounds.compare_exchange_weak(current, packRange(begin + 1, end),
+                                         std::memory_order_acq_rel, std::memory_order_acquire)) {
+            index = int(begin);
+            return true;
+        }
+    }
+}
+
+bool WorkStealingScheduler::steal(int thief, int& index)
+{
+    // Se recorren las victimas empezando por la siguiente; cada ladron
+    // empieza en un lugar distinto, asi que no se amontonan en el mismo hilo
+    for (int k = 1; k < threadCount; ++k) {
+        const int victim = (thief + k) % threadCount;
+        std::atomic<quint64>& bounds = ranges[victim].bounds;
+        quint64 current = bounds.load(std::memory_order_acquire);
+
+        for (;;) {
+            quint32 begin = rangeBegin(current);
+            quint32 end = rangeEnd(current);
+            if (begin >= end) break;
+
+            // La victima se queda con la mitad inicial (la que tiene en cache)
+            quint32 middle = begin + (end - begin) / 2;
+            if (bounds.compare_exchange_weak(current, packRange(begin, middle),
+                                             std::memory_order_acq_rel, std::memory_order_acquire)) {
+                // El tramo propio esta vacio y ningun otro hilo lo modifica
+                // mientras lo este: se guarda el resto de lo robado
+                ranges[thief].bounds.store(packRange(middle + 1, end), std::memory_order_release);
+                steals.fetch_add(1, std::memory_order_relaxed);
+                index = int(middle);
+                return true;
+            }
+        }
+    }
+    return false;
+}
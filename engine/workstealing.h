@@ -0,0 +1,46 @@
+#ifndef WORKSTEALING_H
+#define WORKSTEALING_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+// Reparte los indices [0, count) entre varios hilos con robo de trabajo.
+// Cada hilo empieza con un tramo contiguo del mismo tamaño y toma los
+// indices de su frente; al quedarse sin trabajo le roba la mitad final del
+// tramo a otro hilo y sigue con ella. Los tramos son un par de enteros en
+// un atomico por hilo (en su propia linea de cache), asi que mientras hay
+// trabajo propio ningun hilo toca datos compartidos: sirve para tareas de
+// duracion muy desigual, como partidas completas.
+class WorkStealingScheduler
+{
+public:
+    explicit WorkStealingScheduler(int threadCount = 0);  // 0 = todos los nucleos
+
+    int getThreadCount() const { return threadCount; }
+
+    // Llama a body(index, worker) una vez por indice; worker (de 0 a
+    // getThreadCount() - 1) identifica al hilo para que cada uno use su
+    // propio estado. El hilo que llama es el worker 0. Vuelve cuando
+    // terminaron todos los indices.
+    void run(int count, const std::function<void(int index, int worker)>& body);
+
+    long long getSteals() const { return steals.load(std::memory_order_relaxed); }  // De la ultima run()
+
+private:
+    struct alignas(64) Range
+    {
+        std::atomic<quint64> bounds;  // Inicio en los 32 bits altos, fin en los bajos
+    };
+
+    int threadCount;
+    std::unique_ptr<Range[]> ranges;
+    std::atomic<long long> steals;
+
+    bool takeOwn(int worker, int& index);
+    bool steal(int thief, int& index);
+    void work(int worker, const std::function<void(int, int)>& body);
+};
+
+#endif // WORKSTEALING_H
@@ -1,30 +1,24 @@
-QT       += core gui
+TEMPLATE = subdirs
 
-greaterThan(QT_MAJOR_VERSION, 4): QT += widgets
+# engine:    biblioteca estatica con la fisica del juego (solo QtCore)
+# app:       interfaz grafica (Qt Widgets)
+# simulator: simulador por lotes en linea de comandos
+# levelgen:  generador de niveles grandes
+# benchmark: mediciones de rendimiento del motor y de la interfaz
+# tournament: torneos entre bots en linea de comandos
+# telemetry: conversor de registros de telemetria a CSV
+SUBDIRS += \
+    engine \
+    app \
+    simulator \
+    levelgen \
+    benchmark \
+    tournament \
+    telemetry
 
-CONFIG += c++17
-
-# You can make your code fail to compile if it uses deprecated APIs.
-# In order to do so, uncomment the following line.
-#DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
-
-SOURCES += \
-    gameengine.cpp \
-    infrastructure.cpp \
-    main.cpp \
-    mainwindow.cpp \
-    projectile.cpp
-
-HEADERS += \
-    gameengine.h \
-    infrastructure.h \
-    mainwindow.h \
-    projectile.h
-
-FORMS += \
-    mainwindow.ui
-
-# Default rules for deployment.
-qnx: target.path = /tmp/$${TARGET}/bin
-else: unix:!android: target.path = /opt/$${TARGET}/bin
-!isEmpty(target.path): INSTALLS += target
+app.depends = engine
+simulator.depends = engine
+levelgen.depends = engine
+benchmark.depends = engine
+tournament.depends = engine
+telemetry.depends = engine
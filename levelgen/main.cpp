@@ -0,0 +1,171 @@
+// Generador de niveles: reparte una cantidad grande de bloques (10^5 por
+// defecto) en el campo de cada jugador para medir el motor a escala. El
+// campo del jugador 2 es el reflejo del del jugador 1, asi que el nivel es
+// justo para los dos. La misma semilla produce siempre el mismo nivel.
+
+#include "level.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+static void printUsage(const char* program)
+{
+    std::fprintf(stderr,
+                 "Uso: %s [opciones] <salida>\n"
+                 "\n"
+                 "Genera un nivel en el formato empaquetado (o de texto con --text).\n"
+                 "\n"
+                 "Opciones:\n"
+                 "  --blocks <n>      Bloques en total (por defecto 100000)\n"
+                 "  --seed <n>        Semilla del generador (por defecto 1)\n"
+                 "  --cell <px>       Tamaño de la celda de cada bloque (por defecto 16)\n"
+                 "  --density <f>     Fraccion de celdas ocupadas (por defecto 0.5)\n"
+                 "  --text            Escribir el formato de texto\n"
+                 "  --help            Mostrar esta ayuda\n",
+                 program);
+}
+
+// Entero en [low, high]; se usa la salida cruda de mt19937 (igual en todas
+// las bibliotecas estandar) para que el nivel no dependa del compilador
+static int randomInt(std::mt19937& random, int low, int high)
+{
+    return low + static_cast<int>(random() % static_cast<unsigned>(high - low + 1));
+}
+
+int main(int argc, char *argv[])
+{
+    long long totalBlocks = 100000;
+    unsigned seed = 1;
+    int cell = 16;
+    double density = 0.5;
+    bool text = false;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--blocks") == 0 && i + 1 < argc) {
+            totalBlocks = std::atoll(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--cell") == 0 && i + 1 < argc) {
+            cell = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--density") == 0 && i + 1 < argc) {
+            density = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--text") == 0) {
+            text = true;
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    if (!path) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    if (totalBlocks < 0 || totalBlocks > 20000000 || cell < 4 || !(density > 0 && density <= 1)) {
+        std::fprintf(stderr, "--blocks debe estar entre 0 y 20000000, --cell ser al menos 4 "
+                             "y --density estar en (0, 1]\n");
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    // El jugador 1 recibe el bloque de mas si el total es impar
+    const long long player1Blocks = (totalBlocks + 1) / 2;
+    const long long player2Blocks = totalBlocks / 2;
+
+    // Campo de cada jugador: una rejilla de celdas el doble de ancha que
+    // alta apoyada en el suelo; la zona del rival queda libre en el centro
+    const double rivalWidth = 60, rivalHeight = 110;
+    const long long wanted = static_cast<long long>(std::ceil(player1Blocks / density));
+    int rows = std::max(1, static_cast<int>(std::ceil(std::sqrt(wanted / 2.0))));
+    int columns = std::max(1, static_cast<int>((wanted + rows - 1) / rows));
+    rows = std::max(rows, static_cast<int>(std::ceil((rivalHeight + 2 * cell) / cell)));
+    columns = std::max(columns, static_cast<int>(std::ceil((rivalWidth + 4 * cell) / cell)));
+
+    const double fieldLeft = 120;  // Espacio para el cañon
+    const double fieldTop = 250;   // Los cañones quedan a la altura 175
+    const double fieldWidth = columns * cell;
+    const double middleGap = 30;
+
+    Level level;
+    QRectF rivalZone;
+    std::vector<int> cells;
+
+    // Celdas libres (fuera de la zona del rival y su margen); con densidades
+    // cercanas a 1 puede faltar alguna fila
+    for (;;) {
+        level.floorY = fieldTop + rows * cell;
+        rivalZone = QRectF(fieldLeft + fieldWidth / 2 - rivalWidth / 2, level.floorY - rivalHeight,
+                           rivalWidth, rivalHeight);
+        QRectF keepOut = rivalZone.adjusted(-cell, -cell, cell, 0);
+
+        cells.clear();
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < columns; ++c) {
+                QRectF rect(fieldLeft + c * cell, fieldTop + r * cell, cell, cell);
+                if (!rect.intersects(keepOut)) cells.push_back(r * columns + c);
+            }
+        }
+        if (static_cast<long long>(cells.size()) >= player1Blocks) break;
+        rows++;
+    }
+
+    level.width = 2 * (fieldLeft + fieldWidth + middleGap);
+    level.height = level.floorY + 50;
+    level.cannonPositions[0] = QPointF(35, 175);
+    level.cannonPositions[1] = QPointF(level.width - 35, 175);
+    level.rivalZones[0] = rivalZone;
+    level.rivalZones[1] = QRectF(level.width - rivalZone.right(), rivalZone.top(),
+                                 rivalZone.width(), rivalZone.height());
+
+    // Orden aleatorio de las celdas: las primeras reciben un bloque
+    std::mt19937 random(seed);
+    for (long long i = 0; i < player1Blocks; ++i) {
+        std::swap(cells[i], cells[i + random() % (cells.size() - i)]);
+    }
+
+    level.blocks[0].clear();
+    level.blocks[1].clear();
+    level.blocks[0].reserve(player1Blocks);
+    level.blocks[1].reserve(player2Blocks);
+
+    for (long long i = 0; i < player1Blocks; ++i) {
+        int row = cells[i] / columns;
+        int column = cells[i] % columns;
+
+        // Bloque entero dentro de su celda, sin tocar a los vecinos
+        int w = randomInt(random, cell / 4, cell - 2);
+        int h = randomInt(random, cell / 4, cell - 2);
+        double x = fieldLeft + column * cell + randomInt(random, 1, cell - 1 - w);
+        double y = fieldTop + row * cell + randomInt(random, 1, cell - 1 - h);
+        double resistance = randomInt(random, 2, 20) * 10;
+
+        level.blocks[0].append(Infrastructure(x, y, w, h, resistance));
+        if (i < player2Blocks) {
+            level.blocks[1].append(Infrastructure(level.width - x - w, y, w, h, resistance));
+        }
+    }
+
+    if (!level.saveToFile(QString::fromLocal8Bit(path), !text)) {
+        std::fprintf(stderr, "No se pudo escribir %s\n", path);
+        return 1;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::fprintf(stderr, "%lld bloques en una arena de %gx%g, %s en %.3f s\n",
+                 totalBlocks, level.width, level.height, path, elapsed.count());
+
+    return 0;
+}
@@ -0,0 +1,481 @@
+// Simulador por lotes: lee una lista de disparos (jugador angulo velocidad)
+// y los ejecuta sobre el motor sin interfaz grafica, tan rapido como permita
+// la CPU. Cada disparo se evalua sobre una copia nueva del escenario inicial.
+// Con --sweep recorre en paralelo toda la rejilla de angulos y velocidades y
+// con --batch simula todos los disparos a la vez con el kernel SIMD. Con
+// --replay vuelve a simular partidas grabadas. Con --level se juega sobre
+// un nivel (texto o empaquetado, ver engine/level.h) en vez del tablero original.
+// Con --integrator y --adaptive se elige como avanza la fisica por pasos.
+// Con --telemetry se graban todos los eventos del motor en un registro
+// binario (engine/telemetry.h) que se convierte a CSV con telemetry.
+
+#include "gameengine.h"
+#include "level.h"
+#include "projectilebatch.h"
+#include "replay.h"
+#include "shotrunner.h"
+#include "shotsweep.h"
+#include "telemetry.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct Shot
+{
+    int player;
+    double angle;
+    double speed;
+};
+
+static void printUsage(const char* program)
+{
+    std::fprintf(stderr,
+                 "Uso: %s [opciones] [archivo]\n"
+                 "\n"
+                 "Lee disparos con el formato \"jugador angulo velocidad\" (uno por linea,\n"
+                 "'#' inicia un comentario) desde el archivo o desde la entrada estandar.\n"
+                 "\n"
+                 "Opciones:\n"
+                 "  --level <arch>    Nivel (texto o empaquetado) en vez del tablero original\n"
+                 "  --dt <segundos>   Paso de simulacion (por defecto 0.016)\n"
+                 "  --repeat <n>      Repetir la lista de disparos n veces\n"
+                 "  --quiet           No imprimir el resultado de cada disparo\n"
+                 "  --batch           Simular todos los disparos a la vez (ProjectileBatch)\n"
+                 "  --continuous      Usar colision continua (permite pasos --dt grandes)\n"
+                 "  --events          Saltar de evento en evento con la trayectoria exacta\n"
+                 "  --integrator <m>  Integrador de los pasos: euler (por defecto), simplectico,\n"
+                 "                    verlet, rk4 o exacto\n"
+                 "  --adaptive        Paso adaptativo: entero en vuelo libre, fino cerca de los bloques\n"
+                 "  --sweep <jugador> Evaluar toda la rejilla de angulos y velocidades\n"
+                 "  --angle-step <g>  Paso de angulo de la rejilla (por defecto 1)\n"
+                 "  --speed-step <v>  Paso de velocidad de la rejilla (por defecto 1)\n"
+                 "  --threads <n>     Hilos para --sweep (por defecto todos los nucleos)\n"
+                 "  --replay <arch>   Volver a simular una partida grabada (repetible)\n"
+                 "  --seek <turno>    Con --replay, empezar a imprimir desde ese turno\n"
+                 "  --telemetry <arch> Grabar los eventos del motor en un registro binario (una\n"
+                 "                    partida por repeticion o por vuelta de la lista de disparos)\n"
+                 "  --help            Mostrar esta ayuda\n",
+                 program);
+}
+
+static bool readShots(std::istream& in, std::vector<Shot>& shots)
+{
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        lineNumber++;
+
+        std::string::size_type comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+
+        std::istringstream fields(line);
+        Shot shot;
+        if (!(fields >> shot.player)) {
+            continue;  // Linea vacia
+        }
+
+        if (!(fields >> shot.angle >> shot.speed) || (shot.player != 1 && shot.player != 2)) {
+            std::fprintf(stderr, "Linea %d invalida: se esperaba \"jugador angulo velocidad\"\n", lineNumber);
+            return false;
+        }
+
+        shots.push_back(shot);
+    }
+
+    return true;
+}
+
+static void printResult(int player, double angle, double speed, const ShotResult& result)
+{
+    std::printf("%d,%g,%g,%d,%d,%.3f,%d,%d\n",
+                player, angle, speed, result.winner,
+                result.firstHitIndex, result.damage, result.bounces, result.steps);
+}
+
+static void configureEngine(GameEngine& engine, bool continuous, bool events)
+{
+    engine.setContinuousCollision(continuous);
+    engine.setEventDriven(events);
+}
+
+static int runSweep(const GameEngine& base, int player, const SweepGrid& grid, double dt, int threads,
+                    bool continuous, bool events, bool quiet)
+{
+    GameEngine prototype = base;
+    configureEngine(prototype, continuous, events);
+    if (player == 2) {
+        prototype.switchTurn();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    QVector<ShotResult> results = sweepShots(prototype, grid, dt, threads);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+
+    long long totalSteps = 0;
+    long long wins = 0;
+
+    if (!quiet) {
+        std::printf("player,angle,speed,winner,hit_index,damage,bounces,steps\n");
+    }
+
+    for (int a = 0; a < grid.angleCount(); ++a) {
+        for (int s = 0; s < grid.speedCount(); ++s) {
+            const ShotResult& result = results[grid.cellIndex(a, s)];
+            totalSteps += result.steps;
+            if (result.winner != 0) wins++;
+
+            if (!quiet) {
+                printResult(player, grid.angleAt(a), grid.speedAt(s), result);
+            }
+        }
+    }
+
+    std::fprintf(stderr,
+                 "%lld celdas, %lld pasos en %.3f s (%.0f disparos/s, %.0f pasos/s)\n"
+                 "Disparos ganadores: %lld\n",
+                 static_cast<long long>(results.size()), totalSteps, seconds,
+                 seconds > 0 ? results.size() / seconds : 0.0,
+                 seconds > 0 ? totalSteps / seconds : 0.0,
+                 wins);
+
+    return 0;
+}
+
+// Cierra el registro de telemetria (si se abrio) y dice cuanto se grabo
+static void reportTelemetry(TelemetryLog& telemetry)
+{
+    if (!telemetry.isOpen()) return;
+    telemetry.close();
+    std::fprintf(stderr, "Telemetria: %lld eventos grabados, %lld descartados\n",
+                 telemetry.getWritten(), telemetry.getDropped());
+}
+
+// Vuelve a simular cada repeticion de principio a fin; la salida tiene una
+// fila por turno a partir de seekTurn
+static int runReplays(const std::vector<const char*>& paths, int seekTurn, bool quiet,
+                      TelemetryLog& telemetry)
+{
+    if (!quiet) {
+        std::printf("replay,turn,player,angle,speed,winner,hit_index,damage,bounces,steps\n");
+    }
+
+    long long totalTurns = 0;
+    long long totalSteps = 0;
+    long long wins[3] = {0, 0, 0};
+    std::chrono::duration<double> elapsed(0);
+
+    for (size_t r = 0; r < paths.size(); ++r) {
+        Replay replay;
+        if (!replay.loadFromFile(QString::fromLocal8Bit(paths[r]))) {
+            std::fprintf(stderr, "%s no es una repeticion valida\n", paths[r]);
+            return 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        ReplayPlayer player(replay);
+        player.seek(seekTurn);
+
+        // Solo los turnos que se imprimen
+        if (telemetry.isOpen()) {
+            telemetry.beginMatch(static_cast<quint32>(r));
+            player.setEventCallback(TelemetryLog::collect, &telemetry);
+        }
+
+        while (player.stepTurn()) {
+            const ShotResult& result = player.getLastResult();
+            totalTurns++;
+            totalSteps += result.steps;
+
+            if (!quiet) {
+                const ReplayShot& shot = replay.getShot(player.getTurn() - 1);
+                std::printf("%zu,%d,", r, player.getTurn() - 1);
+                printResult(shot.player, shot.angle, shot.speed, result);
+            }
+        }
+        elapsed += std::chrono::steady_clock::now() - start;
+        wins[player.getEngine().isGameOver() ? player.getEngine().getWinner() : 0]++;
+    }
+
+    double seconds = elapsed.count();
+    std::fprintf(stderr,
+                 "%zu repeticiones, %lld turnos, %lld pasos en %.3f s (%.0f turnos/s, %.0f pasos/s)\n"
+                 "Victorias: jugador 1 = %lld, jugador 2 = %lld, sin terminar = %lld\n",
+                 paths.size(), totalTurns, totalSteps, seconds,
+                 seconds > 0 ? totalTurns / seconds : 0.0,
+                 seconds > 0 ? totalSteps / seconds : 0.0,
+                 wins[1], wins[2], wins[0]);
+
+    return 0;
+}
+
+// Un lote por jugador con todos sus disparos (repetidos) en vuelo a la vez
+static int runBatch(const GameEngine& base, const std::vector<Shot>& shots, long long repeat,
+                    double dt, bool quiet)
+{
+    if (shots.size() * repeat > 100000000LL) {
+        std::fprintf(stderr, "Demasiados disparos para un solo lote\n");
+        return 1;
+    }
+
+    long long totalShots = 0;
+    long long totalSteps = 0;
+    long long wins[3] = {0, 0, 0};
+    std::vector<ShotResult> results(shots.size() * repeat);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int player = 1; player <= 2; ++player) {
+        GameEngine prototype = base;
+        if (player == 2) {
+            prototype.switchTurn();
+        }
+
+        ProjectileBatch batch(prototype);
+        std::vector<size_t> slots;
+        batch.reserve(static_cast<int>(shots.size() * repeat));
+
+        for (long long r = 0; r < repeat; ++r) {
+            for (size_t s = 0; s < shots.size(); ++s) {
+                if (shots[s].player != player) continue;
+                batch.add(shots[s].angle, shots[s].speed);
+                slots.push_back(r * shots.size() + s);
+            }
+        }
+
+        if (batch.size() == 0) continue;
+        batch.run(dt);
+
+        for (int i = 0; i < batch.size(); ++i) {
+            ShotResult result = batch.result(i);
+            results[slots[i]] = result;
+            totalShots++;
+            totalSteps += result.steps;
+            wins[result.winner]++;
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+
+    if (!quiet) {
+        std::printf("player,angle,speed,winner,hit_index,damage,bounces,steps\n");
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Shot& shot = shots[i % shots.size()];
+            printResult(shot.player, shot.angle, shot.speed, results[i]);
+        }
+    }
+
+    std::fprintf(stderr,
+                 "%lld disparos, %lld pasos en %.3f s (%.0f disparos/s, %.0f pasos/s)\n"
+                 "Victorias: jugador 1 = %lld, jugador 2 = %lld\n",
+                 totalShots, totalSteps, seconds,
+                 seconds > 0 ? totalShots / seconds : 0.0,
+                 seconds > 0 ? totalSteps / seconds : 0.0,
+                 wins[1], wins[2]);
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    double dt = 0.016;
+    long long repeat = 1;
+    bool quiet = false;
+    bool batch = false;
+    bool continuous = false;
+    bool events = false;
+    Integrator integrator = Integrator::Euler;
+    bool adaptive = false;
+    int sweepPlayer = 0;
+    int threads = 0;
+    SweepGrid grid;
+    const char* path = nullptr;
+    const char* levelPath = nullptr;
+    std::vector<const char*> replays;
+    int seekTurn = 0;
+    const char* telemetryPath = nullptr;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc) {
+            dt = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = std::atoll(argv[++i]);
+        } else if (std::strcmp(argv[i], "--sweep") == 0 && i + 1 < argc) {
+            sweepPlayer = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--angle-step") == 0 && i + 1 < argc) {
+            grid.angleStep = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--speed-step") == 0 && i + 1 < argc) {
+            grid.speedStep = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            replays.push_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            levelPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--seek") == 0 && i + 1 < argc) {
+            seekTurn = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--telemetry") == 0 && i + 1 < argc) {
+            telemetryPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--integrator") == 0 && i + 1 < argc) {
+            if (!integratorFromName(argv[++i], integrator)) {
+                std::fprintf(stderr, "Integrador desconocido: %s\n", argv[i]);
+                return 1;
+            }
+        } else if (std::strcmp(argv[i], "--adaptive") == 0) {
+            adaptive = true;
+        } else if (std::strcmp(argv[i], "--batch") == 0) {
+            batch = true;
+        } else if (std::strcmp(argv[i], "--continuous") == 0) {
+            continuous = true;
+        } else if (std::strcmp(argv[i], "--events") == 0) {
+            events = true;
+        } else if (std::strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    if (dt <= 0 || repeat < 1) {
+        std::fprintf(stderr, "--dt y --repeat deben ser positivos\n");
+        return 1;
+    }
+
+    if (telemetryPath && (sweepPlayer != 0 || batch)) {
+        std::fprintf(stderr, "--telemetry no se puede usar con --sweep ni con --batch\n");
+        return 1;
+    }
+
+    TelemetryLog telemetry;
+    if (telemetryPath && !telemetry.open(QString::fromLocal8Bit(telemetryPath),
+                                         GameEngine(800, 600).getDamageFactor(),
+                                         GameEngine(800, 600).getProjectileMass())) {
+        std::fprintf(stderr, "No se pudo crear %s\n", telemetryPath);
+        return 1;
+    }
+
+    if (!replays.empty()) {
+        int status = runReplays(replays, seekTurn, quiet, telemetry);
+        reportTelemetry(telemetry);
+        return status;
+    }
+
+    // Escenario inicial de todos los disparos
+    Level level;
+    if (levelPath) {
+        int errorLine = 0;
+        if (!level.loadFromFile(QString::fromLocal8Bit(levelPath), &errorLine)) {
+            if (errorLine > 0) {
+                std::fprintf(stderr, "%s: linea %d invalida\n", levelPath, errorLine);
+            } else {
+                std::fprintf(stderr, "No se pudo leer el nivel %s\n", levelPath);
+            }
+            return 1;
+        }
+    }
+    GameEngine base = level.createEngine();
+    base.setIntegrator(integrator);
+    base.setAdaptiveStep(adaptive);
+
+    if (sweepPlayer != 0) {
+        if (sweepPlayer != 1 && sweepPlayer != 2) {
+            std::fprintf(stderr, "--sweep espera el jugador 1 o 2\n");
+            return 1;
+        }
+        if (grid.angleStep <= 0 || grid.speedStep <= 0) {
+            std::fprintf(stderr, "--angle-step y --speed-step deben ser positivos\n");
+            return 1;
+        }
+        return runSweep(base, sweepPlayer, grid, dt, threads, continuous, events, quiet);
+    }
+
+    std::vector<Shot> shots;
+    if (path) {
+        std::ifstream file(path);
+        if (!file) {
+            std::fprintf(stderr, "No se pudo abrir %s\n", path);
+            return 1;
+        }
+        if (!readShots(file, shots)) return 1;
+    } else {
+        if (!readShots(std::cin, shots)) return 1;
+    }
+
+    if (shots.empty()) {
+        std::fprintf(stderr, "No hay disparos que simular\n");
+        return 1;
+    }
+
+    if (batch) {
+        if (continuous || events || adaptive || integrator != Integrator::Euler) {
+            std::fprintf(stderr, "--batch solo admite la colision discreta con euler y paso fijo\n");
+            return 1;
+        }
+        return runBatch(base, shots, repeat, dt, quiet);
+    }
+
+    if (!quiet) {
+        std::printf("player,angle,speed,winner,hit_index,damage,bounces,steps\n");
+    }
+
+    long long totalShots = 0;
+    long long totalSteps = 0;
+    long long wins[3] = {0, 0, 0};
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (long long r = 0; r < repeat; ++r) {
+        telemetry.beginMatch(static_cast<quint32>(r));
+        for (const Shot& shot : shots) {
+            GameEngine engine = base;
+            configureEngine(engine, continuous, events);
+            if (telemetry.isOpen()) {
+                engine.setEventCallback(TelemetryLog::collect, &telemetry);
+            }
+            if (shot.player == 2) {
+                engine.switchTurn();
+            }
+
+            ShotResult result = runShot(engine, shot.angle, shot.speed, dt);
+
+            totalShots++;
+            totalSteps += result.steps;
+            wins[result.winner]++;
+
+            if (!quiet) {
+                printResult(shot.player, shot.angle, shot.speed, result);
+            }
+        }
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+
+    std::fprintf(stderr,
+                 "%lld disparos, %lld pasos en %.3f s (%.0f disparos/s, %.0f pasos/s)\n"
+                 "Victorias: jugador 1 = %lld, jugador 2 = %lld\n",
+                 totalShots, totalSteps, seconds,
+                 seconds > 0 ? totalShots / seconds : 0.0,
+                 seconds > 0 ? totalSteps / seconds : 0.0,
+                 wins[1], wins[2]);
+
+    reportTelemetry(telemetry);
+    return 0;
+}
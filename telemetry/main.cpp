@@ -0,0 +1,147 @@
+// Lector de registros de telemetria (.l5t, ver engine/telemetry.h): mapea
+// el archivo y convierte cada evento en una fila CSV para analizarlo con
+// otras herramientas. Al final imprime por stderr cuantas partidas,
+// disparos y golpes hubo y cuantos eventos se perdieron.
+
+#include "gameevents.h"
+#include "telemetry.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+
+static void printUsage(const char* program)
+{
+    std::fprintf(stderr,
+                 "Uso: %s [opciones] <registro.l5t>\n"
+                 "\n"
+                 "Imprime una fila CSV por evento:\n"
+                 "match,shot,sequence,time_ns,event,player,index,side,damage,impact_damage,\n"
+                 "resistance,step,projectile,x,y,vx,vy\n"
+                 "impact_damage es damageFactor * masa * rapidez del golpe (antes de limitarlo\n"
+                 "a la resistencia del bloque); en los eventos que no son golpes vale 0.\n"
+                 "\n"
+                 "Opciones:\n"
+                 "  --match <n>       Solo los eventos de esa partida\n"
+                 "  --quiet           No imprimir los eventos, solo el resumen\n"
+                 "  --help            Mostrar esta ayuda\n",
+                 program);
+}
+
+static const char* eventName(quint8 type)
+{
+    if (type == telemetryMatchStart) return "match_start";
+
+    switch (static_cast<GameEventType>(type)) {
+    case GameEventType::Launch: return "launch";
+    case GameEventType::WallBounce: return "wall_bounce";
+    case GameEventType::InfrastructureHit: return "block_hit";
+    case GameEventType::BlockDestroyed: return "block_destroyed";
+    case GameEventType::RivalHit: return "rival_hit";
+    case GameEventType::TurnSwitch: return "turn_switch";
+    case GameEventType::GameOver: return "game_over";
+    }
+    return "unknown";
+}
+
+int main(int argc, char *argv[])
+{
+    const char* path = nullptr;
+    long long matchFilter = -1;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--match") == 0 && i + 1 < argc) {
+            matchFilter = std::atoll(argv[++i]);
+        } else if (std::strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (argv[i][0] == '-' && argv[i][1] != '\0') {
+            printUsage(argv[0]);
+            return 1;
+        } else {
+            path = argv[i];
+        }
+    }
+
+    if (!path) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    QFile file(QString::fromLocal8Bit(path));
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::fprintf(stderr, "No se pudo abrir %s\n", path);
+        return 1;
+    }
+
+    const qint64 size = file.size();
+    const uchar* data = (size >= qint64(sizeof(TelemetryHeader))) ? file.map(0, size) : nullptr;
+    TelemetryHeader header;
+    if (data) std::memcpy(&header, data, sizeof(header));
+    if (!data || std::memcmp(header.magic, "L5TL", 4) != 0 ||
+        header.version != TelemetryLog::formatVersion || header.recordSize != sizeof(TelemetryRecord)) {
+        std::fprintf(stderr, "%s no es un registro de telemetria valido\n", path);
+        return 1;
+    }
+
+    // El mapeo empieza en un limite de pagina y la cabecera mide lo mismo
+    // que un registro: los registros quedan alineados y se leen en su lugar
+    const TelemetryRecord* records = reinterpret_cast<const TelemetryRecord*>(data + sizeof(header));
+    const qint64 capacity = (size - qint64(sizeof(header))) / qint64(sizeof(TelemetryRecord));
+
+    if (!quiet) {
+        std::printf("match,shot,sequence,time_ns,event,player,index,side,damage,impact_damage,"
+                    "resistance,step,projectile,x,y,vx,vy\n");
+    }
+
+    long long count = 0;
+    long long lost = 0;
+    long long shots = 0;
+    long long hits = 0;
+    std::set<quint32> matches;
+    quint32 expected = 1;
+    bool closed = true;
+
+    for (qint64 i = 0; i < capacity; ++i) {
+        const TelemetryRecord& record = records[i];
+        if (record.sequence == 0) {
+            // Resto en ceros de un registro que no se cerro
+            closed = false;
+            break;
+        }
+        lost += record.sequence - expected;
+        expected = record.sequence + 1;
+        count++;
+
+        matches.insert(record.match);
+        const GameEventType type = static_cast<GameEventType>(record.type);
+        const bool hit = (record.type != telemetryMatchStart && type == GameEventType::InfrastructureHit);
+        if (record.type != telemetryMatchStart && type == GameEventType::Launch && record.projectile == 0) shots++;
+        if (hit) hits++;
+
+        if (quiet || (matchFilter >= 0 && record.match != matchFilter)) continue;
+
+        const double impact = hit ? header.damageFactor * header.projectileMass *
+                                    std::sqrt(double(record.vx) * record.vx + double(record.vy) * record.vy)
+                                  : 0.0;
+        std::printf("%u,%u,%u,%lld,%s,%d,%d,%d,%g,%g,%g,%d,%u,%g,%g,%g,%g\n",
+                    record.match, record.shot, record.sequence, static_cast<long long>(record.timeNs),
+                    eventName(record.type), record.player, record.index, record.side,
+                    record.damage, impact, record.resistance, record.step, record.projectile,
+                    record.x, record.y, record.vx, record.vy);
+    }
+
+    std::fprintf(stderr,
+                 "%lld eventos, %zu partidas, %lld disparos, %lld golpes a bloques\n"
+                 "Eventos perdidos (cola llena): %lld\n",
+                 count, matches.size(), shots, hits, lost);
+    if (!closed) {
+        std::fprintf(stderr, "El registro no se cerro: se leyo hasta el ultimo evento escrito\n");
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+#include "bot.h"
+#include "autoaim.h"
+#include "shotplanner.h"
+#include "shotsweep.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Real uniforme en [low, high] con la salida cruda de mt19937, igual en
+// todas las bibliotecas estandar: la misma semilla da el mismo torneo
+static double randomReal(std::mt19937& random, double low, double high)
+{
+    return low + (high - low) * (random() / 4294967295.0);
+}
+
+bool BotPolicy::parse(const char* text, BotPolicy& policy)
+{
+    policy = BotPolicy();
+    policy.name = text;
+
+    if (std::strcmp(text, "random") == 0) {
+        policy.kind = Random;
+        return true;
+    }
+    if (std::strcmp(text, "greedy") == 0) {
+        policy.kind = Greedy;
+        return true;
+    }
+    if (std::strcmp(text, "aim") == 0) {
+        policy.kind = Aim;
+        return true;
+    }
+    if (std::strncmp(text, "greedy:", 7) == 0) {
+        char* end = nullptr;
+        policy.kind = Greedy;
+        policy.aimError = std::strtod(text + 7, &end);
+        return end != text + 7 && *end == '\0' && policy.aimError >= 0;
+    }
+    return false;
+}
+
+Bot::Bot()
+    : engine(800, 600)
+{
+}
+
+void Bot::chooseShot(const BotPolicy& policy, const GameEngine& state, double dt,
+                     std::mt19937& random, double& angle, double& speed)
+{
+    // Mismo rango que los sliders de la interfaz
+    SweepGrid grid;
+
+    if (policy.kind == BotPolicy::Random) {
+        angle = randomReal(random, grid.angleMin, grid.angleMax);
+        speed = randomReal(random, grid.speedMin, grid.speedMax);
+        return;
+    }
+
+    if (policy.kind == BotPolicy::Aim) {
+        if (!chooseAimedShot(state, dt, angle, speed)) {
+            angle = randomReal(random, grid.angleMin, grid.angleMax);
+            speed = randomReal(random, grid.speedMin, grid.speedMax);
+        }
+        return;
+    }
+
+    grid.angleStep = policy.angleStep;
+    grid.speedStep = policy.speedStep;
+    const int player = state.getCurrentPlayer();
+
+    // La copia reutiliza la memoria del motor de trabajo si el escenario es
+    // del mismo tamaño; cada candidato se restaura desde la instantanea
+    engine = state;
+    engine.snapshot(start, startResistance);
+
+    // El primer disparo ganador basta
+    double bestScore = -1.0;
+    bool won = false;
+    angle = grid.angleMin;
+    speed = grid.speedMin;
+    for (int a = 0; a < grid.angleCount() && !won; ++a) {
+        for (int s = 0; s < grid.speedCount() && !won; ++s) {
+            if (!engine.restore(start, startResistance.data())) {
+                engine = state;
+            }
+            const ShotResult result = runShot(engine, grid.angleAt(a), grid.speedAt(s), dt);
+            const double score = scoreShot(result, player);
+            if (score > bestScore) {
+                bestScore = score;
+                angle = grid.angleAt(a);
+                speed = grid.speedAt(s);
+            }
+            won = (result.winner == player);
+        }
+    }
+
+    if (policy.aimError > 0) {
+        angle = std::max(grid.angleMin, std::min(grid.angleMax,
+                angle + randomReal(random, -policy.aimError, policy.aimError)));
+    }
+}
+
+bool Bot::chooseAimedShot(const GameEngine& state, double dt, double& angle, double& speed)
+{
+    AimSettings settings;
+    settings.dt = dt;
+
+    // Velocidades de la mas alta a la mas baja (el rango de los sliders)
+    static const double speeds[] = {300, 275, 250, 225, 200, 175, 150, 125, 100, 75, 50};
+
+    AimSolution best;
+    bool found = false;
+    auto consider = [&](const QVector<AimSolution>& solutions) {
+        if (!solutions.isEmpty() && (!found || solutions.front().clearance > best.clearance)) {
+            best = solutions.front();
+            found = true;
+        }
+    };
+
+    for (double v : speeds) {
+        consider(aimAtRival(state, v, settings));
+    }
+
+    // Sin tiro al rival se abre camino por el bloque mas debil alcanzable
+    const QVector<Infrastructure>& blocks = (state.getCurrentPlayer() == 1)
+        ? state.getPlayer2Infrastructure() : state.getPlayer1Infrastructure();
+    std::vector<int> order;
+    for (int i = 0; i < blocks.size(); ++i) {
+        if (!blocks[i].isDestroyed()) order.push_back(i);
+    }
+    std::stable_sort(order.begin(), order.end(), [&blocks](int a, int b) {
+        return blocks[a].getResistance() < blocks[b].getResistance();
+    });
+    for (size_t i = 0; i < order.size() && !found; ++i) {
+        for (double v : speeds) {
+            consider(aimAtBlock(state, order[i], v, settings));
+        }
+    }
+
+    if (!found) return false;
+    angle = best.angle;
+    speed = best.speed;
+    return true;
+}
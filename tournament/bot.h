@@ -0,0 +1,49 @@
+#ifndef BOT_H
+#define BOT_H
+
+#include "gameengine.h"
+#include <random>
+#include <string>
+#include <vector>
+
+// Como elige sus disparos un bot del torneo
+struct BotPolicy
+{
+    enum Kind { Random, Greedy, Aim };
+
+    Kind kind = Random;
+    double aimError = 0.0;   // Greedy: error de punteria uniforme en +-aimError grados
+    double angleStep = 5.0;  // Greedy: rejilla de angulos y velocidades que prueba
+    double speedStep = 10.0;
+    std::string name;        // Tal como se escribio en la linea de comandos
+
+    // "random", "greedy", "greedy:<error en grados>" o "aim"; false si no se entiende
+    static bool parse(const char* text, BotPolicy& policy);
+};
+
+// Elige los disparos del jugador actual segun una politica. Random tira con
+// angulo y velocidad al azar en el rango de los sliders; Greedy simula toda
+// su rejilla sobre el estado actual y se queda con el de mayor scoreShot
+// (shotplanner.h), sin limite de tiempo para que el resultado no dependa de
+// la carga de la maquina. Aim usa la punteria analitica (autoaim.h): busca
+// un tiro a la zona del rival y si no hay, al bloque enemigo con menos
+// resistencia que pueda alcanzar, con la solucion de mayor holgura; si
+// nada es alcanzable tira al azar. Guarda un motor de trabajo para los candidatos,
+// asi que cada hilo usa su propio Bot.
+class Bot
+{
+public:
+    Bot();
+
+    void chooseShot(const BotPolicy& policy, const GameEngine& state, double dt,
+                    std::mt19937& random, double& angle, double& speed);
+
+private:
+    bool chooseAimedShot(const GameEngine& state, double dt, double& angle, double& speed);
+
+    GameEngine engine;
+    GameState start;
+    std::vector<double> startResistance;
+};
+
+#endif // BOT_H
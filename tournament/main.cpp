@@ -0,0 +1,288 @@
+// Torneo entre bots: juega partidas completas (turnos alternados hasta que
+// alguien gana) entre todas las parejas de politicas sobre uno o varios
+// niveles, sin interfaz grafica. Las partidas se reparten entre los nucleos
+// con robo de trabajo (engine/workstealing.h), porque su duracion varia
+// mucho: una partida entre bots codiciosos puede durar cientos de veces mas
+// que una entre bots al azar. Imprime una fila CSV por partida a medida que
+// terminan (en cualquier orden; la columna match da el orden del plan) y
+// al final las partidas por segundo y las victorias de cada bot.
+
+#include "bot.h"
+#include "level.h"
+#include "shotrunner.h"
+#include "workstealing.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
+
+static void printUsage(const char* program)
+{
+    std::fprintf(stderr,
+                 "Uso: %s [opciones]\n"
+                 "\n"
+                 "Juega todas las parejas de bots (cada uno de los dos lados) en cada nivel e\n"
+                 "imprime una fila CSV por partida:\n"
+                 "match,level,bot1,bot2,round,winner,turns,damage_1,damage_2\n"
+                 "damage_N es la resistencia que perdio cada bloque del jugador N, separada por\n"
+                 "espacios; winner es 0 si se llego a --max-turns.\n"
+                 "\n"
+                 "Opciones:\n"
+                 "  --bot <politica>  Agregar un bot (repetible): random, greedy, greedy:<grados>\n"
+                 "                    (codicioso con ese error de punteria) o aim (punteria analitica);\n"
+                 "                    por defecto random y greedy\n"
+                 "  --level <arch>    Agregar un nivel (repetible); por defecto el tablero original\n"
+                 "  --rounds <n>      Partidas por pareja y nivel (por defecto 10)\n"
+                 "  --max-turns <n>   Disparos por partida antes de declarar empate (por defecto 100)\n"
+                 "  --dt <segundos>   Paso de simulacion (por defecto 0.016)\n"
+                 "  --seed <n>        Semilla de los bots al azar (por defecto 1)\n"
+                 "  --threads <n>     Hilos (por defecto todos los nucleos)\n"
+                 "  --quiet           No imprimir las partidas, solo el resumen\n"
+                 "  --help            Mostrar esta ayuda\n",
+                 program);
+}
+
+// Estado propio de cada hilo: motores de trabajo, salida pendiente y
+// contadores, para que las partidas no compartan nada mientras se juegan
+struct Worker
+{
+    Worker() : engine(800, 600) {}
+
+    Bot bot;
+    GameEngine engine;
+    std::string output;
+    long long turns = 0;
+    long long draws = 0;
+    std::vector<long long> wins;  // Por bot
+};
+
+static void appendDamage(std::string& out, const QVector<Infrastructure>& initial,
+                         const QVector<Infrastructure>& final)
+{
+    char number[32];
+    for (int i = 0; i < initial.size(); ++i) {
+        std::snprintf(number, sizeof(number), i == 0 ? "%g" : " %g",
+                      initial[i].getResistance() - final[i].getResistance());
+        out += number;
+    }
+}
+
+// Campo de texto CSV: entre comillas (y con las comillas duplicadas) si
+// tiene comas, comillas o saltos de linea, como las rutas de los niveles
+static std::string csvField(const std::string& value)
+{
+    if (value.find_first_of(",\"\r\n") == std::string::npos) return value;
+
+    std::string field = "\"";
+    for (char c : value) {
+        if (c == '"') field += '"';
+        field += c;
+    }
+    field += '"';
+    return field;
+}
+
+int main(int argc, char *argv[])
+{
+    std::vector<BotPolicy> bots;
+    std::vector<const char*> levelPaths;
+    int rounds = 10;
+    int maxTurns = 100;
+    double dt = 0.016;
+    unsigned seed = 1;
+    int threads = 0;
+    bool quiet = false;
+
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--bot") == 0 && i + 1 < argc) {
+            BotPolicy policy;
+            if (!BotPolicy::parse(argv[++i], policy)) {
+                std::fprintf(stderr, "Politica desconocida: %s\n", argv[i]);
+                return 1;
+            }
+            bots.push_back(policy);
+        } else if (std::strcmp(argv[i], "--level") == 0 && i + 1 < argc) {
+            levelPaths.push_back(argv[++i]);
+        } else if (std::strcmp(argv[i], "--rounds") == 0 && i + 1 < argc) {
+            rounds = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-turns") == 0 && i + 1 < argc) {
+            maxTurns = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc) {
+            dt = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = static_cast<unsigned>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            threads = std::atoi(argv[++i]);
+        } else if (std::strcmp(argv[i], "--quiet") == 0) {
+            quiet = true;
+        } else if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (rounds < 1 || maxTurns < 1 || dt <= 0) {
+        std::fprintf(stderr, "--rounds, --max-turns y --dt deben ser positivos\n");
+        return 1;
+    }
+
+    if (bots.empty()) {
+        bots.resize(2);
+        BotPolicy::parse("random", bots[0]);
+        BotPolicy::parse("greedy", bots[1]);
+    }
+
+    // Niveles con su nombre para la salida, ya como campo CSV
+    std::vector<Level> levels;
+    std::vector<std::string> levelNames;
+    if (levelPaths.empty()) {
+        levels.push_back(Level());
+        levelNames.push_back("original");
+    }
+    for (const char* path : levelPaths) {
+        Level level;
+        int errorLine = 0;
+        if (!level.loadFromFile(QString::fromLocal8Bit(path), &errorLine)) {
+            if (errorLine > 0) {
+                std::fprintf(stderr, "%s: linea %d invalida\n", path, errorLine);
+            } else {
+                std::fprintf(stderr, "No se pudo leer el nivel %s\n", path);
+            }
+            return 1;
+        }
+        levels.push_back(level);
+        levelNames.push_back(csvField(path));
+    }
+
+    std::vector<GameEngine> bases;
+    for (const Level& level : levels) {
+        bases.push_back(level.createEngine());
+    }
+
+    // Plan: nivel, pareja ordenada de bots (cada uno juega de los dos lados
+    // y tambien contra si mismo) y ronda
+    const int pairs = static_cast<int>(bots.size() * bots.size());
+    const long long planned = static_cast<long long>(levels.size()) * pairs * rounds;
+    if (planned > 0x7fffffff) {
+        std::fprintf(stderr, "Demasiadas partidas (%lld)\n", planned);
+        return 1;
+    }
+    const int matchCount = static_cast<int>(planned);
+
+    WorkStealingScheduler scheduler(threads);
+    std::vector<Worker> workers(scheduler.getThreadCount());
+    for (Worker& worker : workers) {
+        worker.wins.assign(bots.size(), 0);
+    }
+
+    std::mutex outputMutex;
+    auto flush = [&](std::string& output) {
+        std::lock_guard<std::mutex> lock(outputMutex);
+        std::fwrite(output.data(), 1, output.size(), stdout);
+        output.clear();
+    };
+
+    if (!quiet) {
+        std::printf("match,level,bot1,bot2,round,winner,turns,damage_1,damage_2\n");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    scheduler.run(matchCount, [&](int match, int w) {
+        Worker& worker = workers[w];
+        const int level = match / (pairs * rounds);
+        const int pair = (match / rounds) % pairs;
+        const int round = match % rounds;
+        const int bot[3] = {-1, pair / static_cast<int>(bots.size()), pair % static_cast<int>(bots.size())};
+
+        // Cada partida tiene su propia secuencia al azar, asi que el
+        // resultado no depende del hilo que la juegue
+        std::mt19937 random(seed * 0x9E3779B9u + static_cast<unsigned>(match));
+
+        GameEngine& engine = worker.engine;
+        engine = bases[level];
+
+        int turns = 0;
+        while (!engine.isGameOver() && turns < maxTurns) {
+            double angle, speed;
+            const int player = engine.getCurrentPlayer();
+            worker.bot.chooseShot(bots[bot[player]], engine, dt, random, angle, speed);
+            runShot(engine, angle, speed, dt);
+            turns++;
+            if (!engine.isGameOver()) {
+                engine.switchTurn();
+            }
+        }
+
+        const int winner = engine.isGameOver() ? engine.getWinner() : 0;
+        worker.turns += turns;
+        if (winner == 0) {
+            worker.draws++;
+        } else {
+            worker.wins[bot[winner]]++;
+        }
+
+        if (quiet) return;
+
+        // Los nombres se agregan aparte: una ruta larga no cabe en un bufer fijo
+        char number[64];
+        std::snprintf(number, sizeof(number), "%d,", match);
+        worker.output += number;
+        worker.output += levelNames[level];
+        worker.output += ',';
+        worker.output += bots[bot[1]].name;
+        worker.output += ',';
+        worker.output += bots[bot[2]].name;
+        std::snprintf(number, sizeof(number), ",%d,%d,%d,", round, winner, turns);
+        worker.output += number;
+        appendDamage(worker.output, bases[level].getPlayer1Infrastructure(), engine.getPlayer1Infrastructure());
+        worker.output += ',';
+        appendDamage(worker.output, bases[level].getPlayer2Infrastructure(), engine.getPlayer2Infrastructure());
+        worker.output += '\n';
+
+        // Se escribe por bloques para no pelear por la salida en cada partida
+        if (worker.output.size() >= 64 * 1024) {
+            flush(worker.output);
+        }
+    });
+
+    for (Worker& worker : workers) {
+        flush(worker.output);
+    }
+    std::fflush(stdout);
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+
+    long long turns = 0;
+    long long draws = 0;
+    std::vector<long long> wins(bots.size(), 0);
+    for (const Worker& worker : workers) {
+        turns += worker.turns;
+        draws += worker.draws;
+        for (size_t b = 0; b < bots.size(); ++b) {
+            wins[b] += worker.wins[b];
+        }
+    }
+
+    std::fprintf(stderr,
+                 "%d partidas, %lld turnos en %.3f s (%.1f partidas/s, %.0f turnos/s) "
+                 "con %d hilos y %lld robos\n",
+                 matchCount, turns, seconds,
+                 seconds > 0 ? matchCount / seconds : 0.0,
+                 seconds > 0 ? turns / seconds : 0.0,
+                 scheduler.getThreadCount(), scheduler.getSteals());
+    for (size_t b = 0; b < bots.size(); ++b) {
+        std::fprintf(stderr, "%s: %lld victorias\n", bots[b].name.c_str(), wins[b]);
+    }
+    std::fprintf(stderr, "Empates: %lld\n", draws);
+
+    return 0;
+}
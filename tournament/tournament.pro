@@ -0,0 +1,21 @@
+TEMPLATE = app
+TARGET = tournament
+
+QT = core
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+include(../engine/engine.pri)
+
+SOURCES += \
+    bot.cpp \
+    main.cpp
+
+HEADERS += \
+    bot.h
+
+# Default rules for deployment.
+qnx: target.path = /tmp/$${TARGET}/bin
+else: unix:!android: target.path = /opt/$${TARGET}/bin
+!isEmpty(target.path): INSTALLS += target